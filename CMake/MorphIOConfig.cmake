@@ -2,5 +2,6 @@ include(CMakeFindDependencyMacro)
 
 find_dependency(gsl-lite)
 find_dependency(HighFive)
+find_dependency(Threads)
 
 include("${CMAKE_CURRENT_LIST_DIR}/MorphIOTargets.cmake")
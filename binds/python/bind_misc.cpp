@@ -1,9 +1,11 @@
 #include "bind_misc.h"
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
 #include <morphio/collection.h>
+#include <morphio/morphology_batch.h>
 #include <morphio/enums.h>
 #include <morphio/errorMessages.h>
 #include <morphio/types.h>
@@ -200,10 +202,17 @@ void bind_misc(py::module& m) {
         .def_readwrite("section_types",
                        &morphio::Property::SectionLevel::_sectionTypes,
                        "Returns the list of section types")
-        .def_readwrite("children",
-                       &morphio::Property::SectionLevel::_children,
-                       "Returns a dictionary where key is a section ID "
-                       "and value is the list of children section IDs");
+        .def_property(
+            "children",
+            [](const morphio::Property::SectionLevel& level) { return level._children.toMap(); },
+            [](morphio::Property::SectionLevel& level,
+               const std::map<int, std::vector<unsigned int>>& children) {
+                level.setChildren(morphio::Property::ChildrenTable::fromMap(children));
+            },
+            "Returns a dictionary where key is a section ID "
+            "and value is the list of children section IDs\n\n"
+            "Note: the dictionary is a copy, modifying it in place does not change the "
+            "section level; assign a new dictionary instead");
 
     py::class_<morphio::Property::CellLevel>(m,
                                              "CellLevel",
@@ -370,6 +379,50 @@ The iterable returned by `Collection.load_unordered` should only be used while
 Note: This API is 'experimental', meaning it might change in the future.
 )")
 
+        .def(
+            "load_many",
+            [](morphio::Collection* collection,
+               const std::vector<std::string>& morphology_names,
+               unsigned int options,
+               size_t n_threads) {
+                std::vector<morphio::Morphology> morphologies;
+                {
+                    py::gil_scoped_release release;
+                    morphologies = collection->load_many(morphology_names, options, n_threads);
+                }
+                return morphologies;
+            },
+            "morphology_names"_a,
+            "options"_a = morphio::enums::Option::NO_MODIFIER,
+            "n_threads"_a = 0,
+            R"(Load the immutable morphologies `morphology_names`, in that order.
+
+The GIL is released while loading. SWC, ASC and H5 files of a directory are
+loaded on `n_threads` threads (0 means one per hardware thread). Morphologies of
+an HDF5 container are loaded sequentially in `argsort` order, since HDF5 serializes
+reads.
+
+Note: This API is 'experimental', meaning it might change in the future.
+)")
+        .def(
+            "load_batch",
+            [](morphio::Collection* collection,
+               const std::vector<std::string>& morphology_names,
+               unsigned int options,
+               size_t n_threads) {
+                py::gil_scoped_release release;
+                return collection->load_batch(morphology_names, options, n_threads);
+            },
+            "morphology_names"_a,
+            "options"_a = morphio::enums::Option::NO_MODIFIER,
+            "n_threads"_a = 0,
+            R"(Load the morphologies `morphology_names` into a single `MorphologyBatch`.
+
+The morphologies are loaded as with `Collection.load_many`, without holding
+the GIL, and their data is concatenated into flat arrays.
+
+Note: This API is 'experimental', meaning it might change in the future.
+)")
         .def("argsort",
              &morphio::Collection::argsort,
              "morphology_names"_a,
@@ -385,6 +438,107 @@ Note: This API is 'experimental', meaning it might change in the future.
                 const py::object&) { collection->close(); })
         .def("close", &morphio::Collection::close);
 
+    py::class_<morphio::MorphologyBatch>(
+        m,
+        "MorphologyBatch",
+        R"(The data of many morphologies, concatenated into flat arrays.
+
+The sections of the i-th morphology are
+`cell_section_offsets[i]:cell_section_offsets[i + 1]`, its points
+`cell_point_offsets[i]:cell_point_offsets[i + 1]` and its soma points
+`cell_soma_point_offsets[i]:cell_soma_point_offsets[i + 1]`.
+The points of section s are `section_offsets[s]:section_offsets[s + 1]`.
+Section parents are relative to their morphology, -1 for root sections.
+
+Note: This API is 'experimental', meaning it might change in the future.
+)")
+        .def("__len__", &morphio::MorphologyBatch::size)
+        .def_property_readonly(
+            "points",
+            [](const morphio::MorphologyBatch& batch) {
+                const auto& data = batch.points();
+                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            },
+            "Returns the points of all sections of all morphologies")
+        .def_property_readonly(
+            "diameters",
+            [](const morphio::MorphologyBatch& batch) {
+                const auto& data = batch.diameters();
+                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            },
+            "Returns the diameters of all section points")
+        .def_property_readonly(
+            "perimeters",
+            [](const morphio::MorphologyBatch& batch) {
+                const auto& data = batch.perimeters();
+                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            },
+            "Returns the perimeters of all section points, empty unless all morphologies have "
+            "perimeters")
+        .def_property_readonly(
+            "section_offsets",
+            [](const morphio::MorphologyBatch& batch) {
+                const auto& data = batch.sectionOffsets();
+                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            },
+            "Returns the offset in `points` of every section, followed by the number of points")
+        .def_property_readonly(
+            "section_parents",
+            [](const morphio::MorphologyBatch& batch) {
+                const auto& data = batch.sectionParents();
+                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            },
+            "Returns the parent id of every section, relative to its morphology")
+        .def_property_readonly(
+            "section_types",
+            [](const morphio::MorphologyBatch& batch) {
+                const auto& data = batch.sectionTypes();
+                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            },
+            "Returns the type of every section")
+        .def_property_readonly(
+            "soma_points",
+            [](const morphio::MorphologyBatch& batch) {
+                const auto& data = batch.somaPoints();
+                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            },
+            "Returns the soma points of all morphologies")
+        .def_property_readonly(
+            "soma_diameters",
+            [](const morphio::MorphologyBatch& batch) {
+                const auto& data = batch.somaDiameters();
+                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            },
+            "Returns the soma diameters of all morphologies")
+        .def_property_readonly(
+            "soma_types",
+            [](const morphio::MorphologyBatch& batch) {
+                const auto& data = batch.somaTypes();
+                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            },
+            "Returns the soma type of every morphology")
+        .def_property_readonly(
+            "cell_section_offsets",
+            [](const morphio::MorphologyBatch& batch) {
+                const auto& data = batch.cellSectionOffsets();
+                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            },
+            "Returns the offsets of the sections of each morphology")
+        .def_property_readonly(
+            "cell_point_offsets",
+            [](const morphio::MorphologyBatch& batch) {
+                const auto& data = batch.cellPointOffsets();
+                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            },
+            "Returns the offsets of the points of each morphology")
+        .def_property_readonly(
+            "cell_soma_point_offsets",
+            [](const morphio::MorphologyBatch& batch) {
+                const auto& data = batch.cellSomaPointOffsets();
+                return py::array(static_cast<py::ssize_t>(data.size()), data.data());
+            },
+            "Returns the offsets of the soma points of each morphology");
+
     py::class_<morphio::LoadUnordered<morphio::Morphology>>(
         m, "LoadImmutableUnordered", "An iterable of immutable morphologies.")
         .def(
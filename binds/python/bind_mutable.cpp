@@ -106,7 +106,9 @@ void bind_mutable_methods(mutable_binding_classes& mutable_classes) {
         .def("build_read_only",
              &morphio::mut::Morphology::buildReadOnly,
              "Returns the data structure used to create read-only "
-             "morphologies")
+             "morphologies, copying the subtrees of the root sections with "
+             "n_threads threads (0 meaning one per hardware thread)",
+             "n_threads"_a = 1)
         .def("append_root_section",
              static_cast<std::shared_ptr<morphio::mut::Section> (morphio::mut::Morphology::*)(
                  const morphio::Property::PointLevel&, morphio::SectionType)>(
@@ -123,6 +125,20 @@ void bind_mutable_methods(mutable_binding_classes& mutable_classes) {
              "immutable_section"_a,
              "recursive"_a = false)
 
+        .def("append_sections",
+             &morphio::mut::Morphology::appendSections,
+             "Append many sections given as flat arrays, laid out as in the "
+             "read-only morphologies\n"
+             "\n"
+             "Section i holds the points from sections[i][0] to sections[i + 1][0] "
+             "of point_level_properties. Its parent is sections[i][1], the index of "
+             "a previous section in these arrays, or -1 for a new root section\n"
+             "\n"
+             "Returns the new sections, in the order of the arrays",
+             "point_level_properties"_a,
+             "sections"_a,
+             "section_types"_a)
+
         .def("delete_section",
              &morphio::mut::Morphology::deleteSection,
              "Delete the given section\n"
@@ -135,6 +151,18 @@ void bind_mutable_methods(mutable_binding_classes& mutable_classes) {
              "section"_a,
              "recursive"_a = true)
 
+        .def("delete_sections",
+             &morphio::mut::Morphology::deleteSections,
+             "Delete the sections with the given IDs in a single pass\n"
+             "\n"
+             "IDs that are not part of the tree are ignored\n"
+             "\n"
+             "If recursive == true, all descendent sections will be "
+             "deleted as well\n"
+             "Else, children will be re-attached to their closest ancestor that is kept",
+             "section_ids"_a,
+             "recursive"_a = true)
+
         .def("as_immutable",
              [](const morphio::mut::Morphology* morph) { return morphio::Morphology(*morph); })
 
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cstdint>  // uint32_t
+#include <memory>   // std::unique_ptr
+#include <vector>
+
+#include <morphio/morphology.h>
+#include <morphio/spatial_index.h>
+#include <morphio/vector_types.h>
+
+namespace morphio {
+
+/** A 4x4 affine transform, row-major, applied to column vectors: p' = M * (p, 1) */
+using Transform = std::array<std::array<floatType, 4>, 4>;
+
+/** Two segments of different cells whose capsules are within a distance of each other */
+struct SegmentPair {
+    uint32_t cell0;
+    SegmentId segment0;
+    uint32_t cell1;
+    SegmentId segment1;
+};
+
+/**
+ * A spatial index over many morphologies placed in space, to find the candidate touches
+ * between them.
+ *
+ * Every cell has a SegmentIndex in its own frame, and the boxes bounding the placed cells
+ * are organised in a top-level bounding volume hierarchy. The morphologies are shared,
+ * not copied, and the point coordinates are never transformed up front: the segments of
+ * one cell are brought to the frame of another only when their cells' boxes are close.
+ *
+ * The transforms must be rigid, i.e. made of a rotation and a translation, so that the
+ * distances are the same in every frame.
+ *
+ * Note: This API is 'experimental', meaning it might change in the future.
+ */
+class CircuitIndex
+{
+  public:
+    /**
+     * Index `morphologies`, placed by `transforms`, using `n_threads` threads (0 meaning
+     * one per hardware thread)
+     *
+     * @throw MorphioError if the number of morphologies and transforms differ, or if a
+     * transform is not rigid
+     */
+    CircuitIndex(std::vector<Morphology> morphologies,
+                 std::vector<Transform> transforms,
+                 size_t n_threads = 0);
+    ~CircuitIndex();
+
+    /** Return the number of cells */
+    size_t size() const noexcept {
+        return _morphologies.size();
+    }
+
+    /** Return the lower and upper corners of the box bounding the placed cell `cell` */
+    const std::array<Point, 2>& cellBounds(uint32_t cell) const {
+        return _cellBounds.at(cell);
+    }
+
+    /**
+     * Return the pairs of cells (i, j), i < j, whose bounding boxes are within `distance`
+     * of each other, sorted
+     */
+    std::vector<std::array<uint32_t, 2>> cellPairs(floatType distance) const;
+
+    /**
+     * Return the pairs of segments of different cells whose capsules are within `distance`
+     * of each other, using `n_threads` threads. Pairs are sorted by cells, `cell0` < `cell1`.
+     */
+    std::vector<SegmentPair> segmentPairs(floatType distance, size_t n_threads = 0) const;
+
+  private:
+    /** Return the segment pairs between cell `cell0` and cell `cell1` */
+    std::vector<SegmentPair> segmentPairs(uint32_t cell0,
+                                          uint32_t cell1,
+                                          floatType distance) const;
+
+    std::vector<Morphology> _morphologies;
+    std::vector<Transform> _transforms;
+    std::vector<std::unique_ptr<SegmentIndex>> _cellIndices;
+    std::vector<std::array<Point, 2>> _cellBounds;
+    /** The top-level hierarchy over `_cellBounds`, whose leaf order is `_cellOrder` */
+    std::vector<detail::BVHNode> _nodes;
+    std::vector<uint32_t> _cellOrder;
+};
+
+}  // namespace morphio
@@ -1,13 +1,16 @@
 #pragma once
 
+#include <future>
 #include <memory>
 #include <string>
 
 #include <morphio/morphology.h>
+#include <morphio/morphology_batch.h>
 #include <morphio/mut/morphology.h>
 
 namespace morphio {
 
+class AsyncLoader;
 class CollectionImpl;
 
 template <class M>
@@ -34,8 +37,10 @@ class Collection
      * Create a collection from the given path.
      *
      * If `collection_path` points to an HDF5 file, then that file
-     * must be a container. Otherwise the `collection_path` should
-     * point to the directory containing the morphology files.
+     * must be a container. If it points to a morphology pack (see
+     * `MorphologyPack`), the morphologies are loaded from that pack.
+     * Otherwise the `collection_path` should point to the directory
+     * containing the morphology files.
      *
      * If the collection path is a directory, the extension of the morphology
      * file must be guessed. The optional argument `extensions` specifies which
@@ -59,6 +64,28 @@ class Collection
     typename enable_if_immutable<M, M>::type load(const std::string& morph_name,
                                                   unsigned int options = NO_MODIFIER) const;
 
+    /**
+     * Load the morphology in the background.
+     *
+     * The load is performed by a thread pool owned by the collection (and shared by
+     * its copies). Concurrent requests for morphologies of an HDF5 container are
+     * served in the order returned by `argsort`, under the HDF5 lock. Errors are
+     * reported when calling `get` on the returned future.
+     *
+     * Note: This API is 'experimental', meaning it might change in the future.
+     */
+    template <class M>
+    std::future<M> load_async(const std::string& morph_name,
+                              unsigned int options = NO_MODIFIER) const;
+
+    /**
+     * Set the number of threads used by `load_async`.
+     *
+     * By default, one thread per hardware thread is used. Requests made before
+     * the call are completed by the previous threads.
+     */
+    void set_async_threads(size_t n_threads);
+
     /**
      * Returns an iterable of loop index, morphology pairs.
      *
@@ -68,6 +95,31 @@ class Collection
     LoadUnordered<M> load_unordered(std::vector<std::string> morphology_names,
                                     unsigned int options = NO_MODIFIER) const;
 
+    /**
+     * Load the morphologies `morphology_names`, using `n_threads` threads.
+     *
+     * The `i`-th morphology returned is `morphology_names[i]`. If `n_threads` is 0,
+     * one thread per hardware thread is used. Morphologies of an HDF5 container are
+     * loaded by the calling thread in `argsort` order, since HDF5 serializes reads.
+     *
+     * Note: This API is 'experimental', meaning it might change in the future.
+     */
+    std::vector<Morphology> load_many(const std::vector<std::string>& morphology_names,
+                                      unsigned int options = NO_MODIFIER,
+                                      size_t n_threads = 0) const;
+
+    /**
+     * Load the morphologies `morphology_names` into a single MorphologyBatch.
+     *
+     * The `i`-th cell of the batch is the morphology `morphology_names[i]`.
+     * Morphologies are loaded as with `load_many`.
+     *
+     * Note: This API is 'experimental', meaning it might change in the future.
+     */
+    MorphologyBatch load_batch(const std::vector<std::string>& morphology_names,
+                               unsigned int options = NO_MODIFIER,
+                               size_t n_threads = 0) const;
+
     /**
      * Returns the reordered loop indices.
      *
@@ -93,6 +145,7 @@ class Collection
 
   private:
     std::shared_ptr<CollectionImpl> _collection;
+    std::shared_ptr<AsyncLoader> _async_loader;
 };
 
 class LoadUnorderedImpl;
@@ -184,6 +237,12 @@ Collection::load<mut::Morphology>(const std::string& morph_name, unsigned int op
 extern template typename enable_if_immutable<Morphology, Morphology>::type
 Collection::load<Morphology>(const std::string& morph_name, unsigned int options) const;
 
+extern template std::future<Morphology> Collection::load_async<Morphology>(
+    const std::string& morph_name, unsigned int options) const;
+
+extern template std::future<mut::Morphology> Collection::load_async<mut::Morphology>(
+    const std::string& morph_name, unsigned int options) const;
+
 extern template LoadUnordered<Morphology> Collection::load_unordered<Morphology>(
     std::vector<std::string> morphology_names, unsigned int options) const;
 
@@ -10,8 +10,8 @@
 
 namespace morphio {
 using mito_upstream_iterator = upstream_iterator_t<MitoSection>;
-using mito_breadth_iterator = morphio::breadth_iterator_t<MitoSection, Mitochondria>;
-using mito_depth_iterator = morphio::depth_iterator_t<MitoSection, Mitochondria>;
+using mito_breadth_iterator = morphio::section_order_iterator_t<MitoSection>;
+using mito_depth_iterator = morphio::section_order_iterator_t<MitoSection>;
 
 /** Mitochondria section */
 class MitoSection: public SectionBase<MitoSection>
@@ -68,6 +68,7 @@ class MitoSection: public SectionBase<MitoSection>
         : SectionBase(id, morphology) {}
     friend MitoSection Mitochondria::section(uint32_t) const;
     friend class SectionBase<MitoSection>;
+    friend class section_order_iterator_t<MitoSection>;
     friend class mut::MitoSection;
 };
 }  // namespace morphio
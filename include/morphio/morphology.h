@@ -8,9 +8,9 @@
 namespace morphio {
 
 /** Morphology breadth iterator */
-using breadth_iterator = breadth_iterator_t<Section, Morphology>;
+using breadth_iterator = section_order_iterator_t<Section>;
 /** Morphology depth iterator */
-using depth_iterator = depth_iterator_t<Section, Morphology>;
+using depth_iterator = section_order_iterator_t<Section>;
 
 /** Class that gives read access to a Morphology file.
  *
@@ -82,12 +82,40 @@ class Morphology
      */
     Section section(uint32_t id) const;
 
+    /**
+     * Return a non-owning view of the section with the given id.
+     *
+     * The view must not outlive this morphology, see morphio::SectionView.
+     *
+     * @throw RawDataError if the id is out of range
+     */
+    SectionView sectionView(uint32_t id) const;
+
+    /** Return non-owning views of the root sections, see morphio::SectionView */
+    SectionViewRange rootSectionViews() const noexcept;
+
     /**
      * Return a vector with all points from all sections
      * (soma points are not included)
      **/
     const Points& points() const noexcept;
 
+    /**
+     * Return the points and diameters of all sections in structure-of-arrays layout,
+     * with each array aligned to 64 bytes.
+     *
+     * The arrays are built on first call and kept as long as the morphology data.
+     **/
+    PointsSoAView pointsSoA() const;
+
+    /**
+     * Return the path distance of every point of points(): the length of the path along
+     * the sections from the first point of the root section to that point.
+     *
+     * The distances are computed on first call and kept as long as the morphology data.
+     **/
+    const std::vector<floatType>& pathDistances() const;
+
     /**
      * Returns a list with offsets to access data of a specific section in the points
      * and diameters arrays.
@@ -149,7 +177,15 @@ class Morphology
 
   protected:
     friend class mut::Morphology;
-    Morphology(const Property::Properties& properties, unsigned int options);
+    friend class MorphologyBatch;
+    friend class MorphologyPack;
+    friend class SegmentIndex;
+    friend Morphometrics computeMorphometrics(const Morphology& morphology);
+    /** Take ownership of `properties`: pass an rvalue to avoid copying the data */
+    Morphology(Property::Properties properties, unsigned int options);
+
+    /** Share `properties`, as built by mut::Morphology::buildReadOnly() */
+    explicit Morphology(std::shared_ptr<Property::Properties> properties);
 
     std::shared_ptr<Property::Properties> properties_;
 
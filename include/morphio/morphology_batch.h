@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdint>  // uint64_t
+#include <vector>
+
+#include <morphio/morphology.h>
+#include <morphio/types.h>
+
+namespace morphio {
+
+/**
+ * The data of many morphologies, concatenated into flat arrays.
+ *
+ * The arrays follow the compressed sparse row (CSR) convention: the sections of
+ * the `i`-th morphology are `[cellSectionOffsets()[i], cellSectionOffsets()[i + 1])`,
+ * its points `[cellPointOffsets()[i], cellPointOffsets()[i + 1])` and its soma points
+ * `[cellSomaPointOffsets()[i], cellSomaPointOffsets()[i + 1])`.
+ *
+ * The points of section `s` are `[sectionOffsets()[s], sectionOffsets()[s + 1])`,
+ * where `sectionOffsets()` indexes the concatenated `points()` and has one trailing
+ * element equal to the total number of points. Section parents are the ids used by
+ * `Morphology::section`, i.e. relative to the morphology, with -1 for root sections.
+ *
+ * Note: This API is 'experimental', meaning it might change in the future.
+ */
+class MorphologyBatch
+{
+  public:
+    MorphologyBatch();
+
+    /** Append the data of `morphology` as a new cell */
+    void append(const Morphology& morphology);
+
+    /** Return the number of morphologies in the batch */
+    size_t size() const noexcept {
+        return _cellSectionOffsets.size() - 1;
+    }
+
+    /** Return the points of all sections of all morphologies */
+    const Points& points() const noexcept {
+        return _points;
+    }
+
+    /** Return the diameters of all section points */
+    const std::vector<floatType>& diameters() const noexcept {
+        return _diameters;
+    }
+
+    /**
+     * Return the perimeters of all section points
+     *
+     * Perimeters are only stored if all morphologies of the batch have some, otherwise
+     * this vector is empty.
+     */
+    const std::vector<floatType>& perimeters() const noexcept {
+        return _perimeters;
+    }
+
+    /** Return the offset in `points()` of every section, followed by the number of points */
+    const std::vector<uint64_t>& sectionOffsets() const noexcept {
+        return _sectionOffsets;
+    }
+
+    /** Return the parent id of every section, relative to its morphology */
+    const std::vector<int32_t>& sectionParents() const noexcept {
+        return _sectionParents;
+    }
+
+    /** Return the type of every section */
+    const std::vector<SectionType>& sectionTypes() const noexcept {
+        return _sectionTypes;
+    }
+
+    /** Return the soma points of all morphologies */
+    const Points& somaPoints() const noexcept {
+        return _somaPoints;
+    }
+
+    /** Return the soma diameters of all morphologies */
+    const std::vector<floatType>& somaDiameters() const noexcept {
+        return _somaDiameters;
+    }
+
+    /** Return the soma type of every morphology */
+    const std::vector<SomaType>& somaTypes() const noexcept {
+        return _somaTypes;
+    }
+
+    /** Return the CSR offsets of the sections of each morphology */
+    const std::vector<uint64_t>& cellSectionOffsets() const noexcept {
+        return _cellSectionOffsets;
+    }
+
+    /** Return the CSR offsets of the points of each morphology */
+    const std::vector<uint64_t>& cellPointOffsets() const noexcept {
+        return _cellPointOffsets;
+    }
+
+    /** Return the CSR offsets of the soma points of each morphology */
+    const std::vector<uint64_t>& cellSomaPointOffsets() const noexcept {
+        return _cellSomaPointOffsets;
+    }
+
+  private:
+    friend class MorphologyPack;
+
+    void reserve(size_t cellCount, size_t sectionCount, size_t pointCount, size_t somaPointCount);
+
+    // `perimeters` is nullptr when the cell has no perimeters
+    void appendCell(const Point* points,
+                    const floatType* diameters,
+                    const floatType* perimeters,
+                    size_t pointCount,
+                    const Property::Section::Type* sections,
+                    const SectionType* sectionTypes,
+                    size_t sectionCount,
+                    const Point* somaPoints,
+                    const floatType* somaDiameters,
+                    size_t somaPointCount,
+                    SomaType somaType);
+
+    Points _points;
+    std::vector<floatType> _diameters;
+    std::vector<floatType> _perimeters;
+    std::vector<uint64_t> _sectionOffsets;
+    std::vector<int32_t> _sectionParents;
+    std::vector<SectionType> _sectionTypes;
+    Points _somaPoints;
+    std::vector<floatType> _somaDiameters;
+    std::vector<SomaType> _somaTypes;
+    std::vector<uint64_t> _cellSectionOffsets;
+    std::vector<uint64_t> _cellPointOffsets;
+    std::vector<uint64_t> _cellSomaPointOffsets;
+    bool _hasPerimeters = true;
+};
+
+}  // namespace morphio
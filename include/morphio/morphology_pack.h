@@ -0,0 +1,129 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <morphio/morphology.h>
+#include <morphio/morphology_batch.h>
+#include <morphio/types.h>
+
+namespace morphio {
+
+class Collection;
+class MorphologyPackImpl;
+
+/**
+ * The neuronal arrays of a morphology stored in a pack, pointing into the mapped file.
+ *
+ * The view shares the ownership of the mapping, so it stays valid after the
+ * MorphologyPack it comes from is destroyed.
+ */
+struct PackedMorphology {
+    range<const Point> points;
+    range<const floatType> diameters;
+    /** Empty if the morphology has no perimeters */
+    range<const floatType> perimeters;
+    range<const Property::Section::Type> sections;
+    range<const SectionType> sectionTypes;
+    range<const Point> somaPoints;
+    range<const floatType> somaDiameters;
+    SomaType somaType = SOMA_UNDEFINED;
+    CellFamily cellFamily = CellFamily::NEURON;
+
+    std::shared_ptr<const MorphologyPackImpl> owner;
+};
+
+/**
+ * A read-only, memory-mapped set of morphologies.
+ *
+ * A morphology pack is a single binary file holding many morphologies whose
+ * point, diameter, perimeter, section and section type arrays are stored
+ * exactly as `Property::Properties` lays them out in memory. Every array is
+ * aligned to a cache line and no parsing of the individual samples is needed.
+ *
+ * `view` returns the arrays of a morphology straight from the mapped file,
+ * without copying them. `load` and `loadBatch` copy the arrays into memory
+ * owned by the returned objects, as `Morphology` owns its data.
+ *
+ * Since the file is mapped read-only, all processes of a node opening the same
+ * pack share its pages through the page cache.
+ *
+ * Note: the pack is written with the floating point type MorphIO was compiled
+ * with (see MORPHIO_USE_DOUBLE) and the native byte order; opening a pack
+ * written with a different configuration raises a RawDataError.
+ *
+ * Note: This API is 'experimental', meaning it might change in the future.
+ */
+class MorphologyPack
+{
+  public:
+    /** Map the pack stored at `path`. */
+    explicit MorphologyPack(const std::string& path);
+
+    /** Return the number of morphologies in the pack */
+    size_t size() const noexcept;
+
+    /** Return the names of the morphologies, in the order they are stored */
+    const std::vector<std::string>& names() const noexcept;
+
+    /** Return true if a morphology named `name` is stored in the pack */
+    bool contains(const std::string& name) const;
+
+    /**
+     * Return the index of the morphology named `name`.
+     *
+     * @throw MorphioError if there is no morphology with this name
+     */
+    size_t index(const std::string& name) const;
+
+    /** Return the arrays of the morphology named `name`, without copying them */
+    PackedMorphology view(const std::string& name) const;
+
+    /** Return the arrays of the morphology stored at position `index`, without copying them */
+    PackedMorphology view(size_t index) const;
+
+    /** Load the morphology named `name` */
+    Morphology load(const std::string& name, unsigned int options = NO_MODIFIER) const;
+
+    /** Load the morphology stored at position `index` */
+    Morphology load(size_t index, unsigned int options = NO_MODIFIER) const;
+
+    /**
+     * Load the morphologies `names` into a single batch.
+     *
+     * Without modifiers, the arrays are copied straight from the mapped file
+     * into the presized batch, no intermediate Morphology is created.
+     */
+    MorphologyBatch loadBatch(const std::vector<std::string>& names,
+                              unsigned int options = NO_MODIFIER) const;
+
+    /**
+     * Return the file offset of the first array of the morphology at `index`.
+     *
+     * Loading morphologies by increasing offset results in sequential reads.
+     */
+    size_t offset(size_t index) const;
+
+    /**
+     * Write the morphologies `names` of `collection` to a new pack at `path`.
+     *
+     * Morphologies are loaded one at a time, so the memory needed does not depend on
+     * the number of morphologies. The modifiers `options` are applied before the
+     * data is stored.
+     *
+     * Note: annotations and markers are not stored in the pack.
+     */
+    static void write(const std::string& path,
+                      const Collection& collection,
+                      const std::vector<std::string>& names,
+                      unsigned int options = NO_MODIFIER);
+
+    /** Return true if the file at `path` starts with the morphology pack signature */
+    static bool isPack(const std::string& path);
+
+  private:
+    std::shared_ptr<const MorphologyPackImpl> _impl;
+};
+
+}  // namespace morphio
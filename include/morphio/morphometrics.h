@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+#include <morphio/properties.h>
+#include <morphio/types.h>
+
+namespace morphio {
+
+/**
+ * Lengths, lateral surface areas and volumes of the neurites of a morphology.
+ *
+ * A segment joins two consecutive points of a section and is modelled as a frustum
+ * whose end diameters are the point diameters. The values of a segment are stored at
+ * the index of its first point: the segment arrays have one element per point, and
+ * the element of the last point of every section is 0. Summing the segment values
+ * over the points of a section thus gives the section value.
+ *
+ * Neurite totals are given per root section, in the order of Morphology::rootSections(),
+ * and sum the values of all sections of the neurite.
+ */
+struct Morphometrics {
+    std::vector<floatType> segmentLengths;
+    std::vector<floatType> segmentAreas;
+    std::vector<floatType> segmentVolumes;
+
+    std::vector<floatType> sectionLengths;
+    std::vector<floatType> sectionAreas;
+    std::vector<floatType> sectionVolumes;
+
+    std::vector<floatType> neuriteLengths;
+    std::vector<floatType> neuriteAreas;
+    std::vector<floatType> neuriteVolumes;
+};
+
+/** Compute the morphometrics of the sections described by `properties` */
+Morphometrics computeMorphometrics(const Property::Properties& properties);
+
+/** Compute the morphometrics of `morphology` */
+Morphometrics computeMorphometrics(const Morphology& morphology);
+
+/**
+ * Compute the morphometrics of every morphology of `morphologies`, using `n_threads`
+ * threads (0 means one per hardware thread)
+ */
+std::vector<Morphometrics> computeMorphometrics(const std::vector<Morphology>& morphologies,
+                                                size_t n_threads = 0);
+
+}  // namespace morphio
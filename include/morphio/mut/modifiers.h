@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>  // size_t
+
 namespace morphio {
 namespace mut {
 
@@ -8,13 +10,19 @@ class Morphology;
 namespace modifiers {
 /**
    Only the first and last points of each sections are kept
+
+   The sections are processed independently, using `n_threads` threads (0 meaning one per
+   hardware thread)
 **/
-void two_points_sections(morphio::mut::Morphology& morpho);
+void two_points_sections(morphio::mut::Morphology& morpho, size_t n_threads = 1);
 
 /**
    Remove duplicated points
+
+   The sections are processed independently, using `n_threads` threads (0 meaning one per
+   hardware thread)
 **/
-void no_duplicate_point(morphio::mut::Morphology& morpho);
+void no_duplicate_point(morphio::mut::Morphology& morpho, size_t n_threads = 1);
 
 /**
    Reduce the soma to a sphere placed at the center of gravity of soma points
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>  // uint64_t
+#include <deque>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <stdexcept>  // std::out_of_range
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -21,6 +26,31 @@ namespace mut {
 bool _checkDuplicatePoint(const std::shared_ptr<Section>& parent,
                           const std::shared_ptr<Section>& current);
 
+/**
+ * A read-only version of a mut::Morphology, as built by Morphology::buildSnapshot().
+ *
+ * Passed to the next buildSnapshot() call of the same morphology, it provides the point data
+ * of the sections that did not change since, which is then copied by contiguous runs.
+ */
+class Snapshot
+{
+  public:
+    /** Return the read-only morphology, null for a default constructed snapshot */
+    const std::shared_ptr<const morphio::Morphology>& morphology() const noexcept {
+        return _morphology;
+    }
+
+  private:
+    friend class Morphology;
+
+    std::shared_ptr<const morphio::Morphology> _morphology;
+    /** The key of the mut::Morphology the snapshot was built from */
+    uint64_t _key = 0;
+    /** The position and the version of every section in the snapshot, indexed by section ID */
+    std::vector<uint32_t> _positions;
+    std::vector<uint64_t> _versions;
+};
+
 /** Mutable(editable) morphio::Morphology */
 class Morphology
 {
@@ -57,10 +87,13 @@ class Morphology
         return _rootSections;
     }
 
-    /// Returns the dictionary id -> Section for this tree
-    const std::map<uint32_t, std::shared_ptr<Section>>& sections() const noexcept {
-        return _sections;
-    }
+    /**
+       Returns the dictionary id -> Section for this tree
+
+       Note: the dictionary is derived from the sections on the first call following a
+       change of the tree; a reference kept across changes is only updated by that call.
+    **/
+    const std::map<uint32_t, std::shared_ptr<Section>>& sections() const;
 
     /**
        Returns a shared pointer on the Soma
@@ -116,7 +149,10 @@ class Morphology
        Note: multiple morphologies can share the same Section instances.
     **/
     const std::shared_ptr<Section>& section(uint32_t id) const {
-        return _sections.at(id);
+        if (!_hasSection(id)) {
+            throw std::out_of_range("No section with id " + std::to_string(id));
+        }
+        return _sectionSlots[id];
     }
 
     /**
@@ -146,6 +182,17 @@ class Morphology
     **/
     void deleteSection(std::shared_ptr<Section> section, bool recursive = true);
 
+    /**
+       Delete the sections with the given IDs, in a single pass over the tree
+
+       IDs that are not part of the tree are ignored
+
+       If recursive == true, all descendent sections will be deleted as well
+       Else, children will be re-attached to their closest ancestor that is kept, at the
+       position of their deleted parent
+    **/
+    void deleteSections(const std::vector<uint32_t>& sectionIds, bool recursive = true);
+
     /**
        Append the existing morphio::Section as a root section
 
@@ -165,7 +212,30 @@ class Morphology
     std::shared_ptr<Section> appendRootSection(const Property::PointLevel&,
                                                SectionType sectionType);
 
-    void applyModifiers(unsigned int modifierFlags);
+    /**
+       Append many sections given as flat arrays, laid out as in Property::Properties
+
+       Section i holds the points [sections[i][0], sections[i + 1][0]) of pointProperties,
+       the last one up to the end of the points. Its parent is sections[i][1], an index in
+       these arrays lower than i, or -1 for a new root section. A child of type
+       SECTION_UNDEFINED takes the type of its parent.
+
+       Return the new sections, in the order of the arrays
+
+       Throws SectionBuilderError if the arrays are inconsistent
+    **/
+    std::vector<std::shared_ptr<Section>> appendSections(
+        const Property::PointLevel& pointProperties,
+        const std::vector<Property::Section::Type>& sections,
+        const std::vector<SectionType>& sectionTypes);
+
+    /**
+       Apply the modifiers `modifierFlags`, the per-section ones using `n_threads` threads
+       (0 meaning one per hardware thread)
+
+       Note: the constructors taking options apply them with a single thread
+    **/
+    void applyModifiers(unsigned int modifierFlags, size_t n_threads = 1);
 
     /// Return the soma type
     SomaType somaType() const noexcept {
@@ -193,8 +263,23 @@ class Morphology
         _cellProperties->_markers.push_back(marker);
     }
 
-    /// Return the data structure used to create read-only morphologies
-    Property::Properties buildReadOnly() const;
+    /**
+     * Return the data structure used to create read-only morphologies
+     *
+     * The subtrees of the root sections are copied by `n_threads` threads (0 meaning one per
+     * hardware thread). The point data of the sections copied from a morphio::Morphology
+     * and not accessed since is copied from it, by contiguous runs.
+     */
+    Property::Properties buildReadOnly(size_t n_threads = 1) const;
+
+    /**
+     * Return a read-only version of the morphology, built like buildReadOnly().
+     *
+     * The point data of the sections left unchanged since `previous` was built from this
+     * morphology is copied from it. A section counts as changed once its point data was
+     * accessed mutably, even if it was never edited.
+     */
+    Snapshot buildSnapshot(const Snapshot& previous = Snapshot(), size_t n_threads = 1) const;
 
     /**
      * Return the graph connectivity of the morphology where each section
@@ -216,23 +301,52 @@ class Morphology
     morphio::Property::DendriticSpine::Level _dendriticSpineLevel;
 
   private:
+    /** The parent ID of root sections */
+    static constexpr uint32_t noParent = 0xffffffff;
+
     std::vector<std::shared_ptr<Section>> _rootSections;
-    std::map<uint32_t, std::shared_ptr<Section>> _sections;
+    /** The sections by ID as returned by sections(), rebuilt from `_sectionSlots` if stale */
+    mutable std::map<uint32_t, std::shared_ptr<Section>> _sections;
+    mutable std::atomic<bool> _sectionsStale{false};
+    mutable std::mutex _sectionsMutex;
 
     Mitochondria _mitochondria;
 
-    std::map<uint32_t, uint32_t> _parent;
-    std::map<uint32_t, std::vector<std::shared_ptr<Section>>> _children;
+    /**
+     * The section, the parent ID and the children of every section, indexed by section ID.
+     *
+     * IDs are never reused: the slot of a deleted section is null, and the containers grow
+     * with `_counter`. Deques keep the references returned by section(), Section::parent()
+     * and Section::children() valid while sections are added.
+     */
+    std::deque<std::shared_ptr<Section>> _sectionSlots;
+    std::vector<uint32_t> _parent;
+    std::deque<std::vector<std::shared_ptr<Section>>> _children;
 
     uint32_t _counter = 0;
+    /** Identifies the morphology in the snapshots built from it, copies getting a new key */
+    uint64_t _key = _nextKey();
+
+    static uint64_t _nextKey() noexcept;
+
+    bool _hasSection(uint32_t id) const noexcept {
+        return id < _sectionSlots.size() && _sectionSlots[id] != nullptr;
+    }
 
     uint32_t _register(const std::shared_ptr<Section>&);
     morphio::readers::ErrorMessages _err;
 
-    void eraseByValue(std::vector<std::shared_ptr<Section>>& vec,
-                      const std::shared_ptr<Section> section);
+    /**
+     * Return the section IDs in depth first order, filling `rootStarts` with the position of
+     * each root section followed by the number of sections
+     */
+    std::vector<uint32_t> _depthFirstOrder(std::vector<size_t>& rootStarts) const;
+
+    /** Build the read-only properties, copying unchanged sections from `previous` if set */
+    Property::Properties _buildReadOnly(const Snapshot* previous, size_t n_threads) const;
 
     friend class Section;
+    friend class morphio::Morphology;
     friend void modifiers::nrn_order(morphio::mut::Morphology& morpho);
     friend bool diff(const Morphology& left,
                      const Morphology& right,
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <functional>
+#include <mutex>  // std::call_once
 
+#include <morphio/mut/modifiers.h>
 #include <morphio/properties.h>
 #include <morphio/section.h>
 #include <morphio/types.h>
@@ -35,30 +37,38 @@ class Section: public std::enable_shared_from_this<Section>
 
     /** @{
        Return the coordinates (x,y,z) of all points of this section
+
+       The point data of a section copied from a morphio::Section is only copied from the
+       read-only morphology when first accessed. Until it is accessed mutably, the section
+       keeps the whole read-only morphology data alive.
+
+       Note: calling the non-const accessors marks the section as modified for all the
+       following snapshots (see Morphology::buildSnapshot), as the reference returned may be
+       used to edit the data at any time; read through a const Section to avoid it.
     **/
-    inline std::vector<Point>& points() noexcept;
-    inline const std::vector<Point>& points() const noexcept;
+    inline std::vector<Point>& points();
+    inline const std::vector<Point>& points() const;
     /** @} */
 
     /** @{
        Return the diameters of all points of this section
     **/
-    inline std::vector<morphio::floatType>& diameters() noexcept;
-    inline const std::vector<morphio::floatType>& diameters() const noexcept;
+    inline std::vector<morphio::floatType>& diameters();
+    inline const std::vector<morphio::floatType>& diameters() const;
     /** @} */
 
     /** @{
        Return the perimeters of all points of this section
     **/
-    inline std::vector<morphio::floatType>& perimeters() noexcept;
-    inline const std::vector<morphio::floatType>& perimeters() const noexcept;
+    inline std::vector<morphio::floatType>& perimeters();
+    inline const std::vector<morphio::floatType>& perimeters() const;
     /** @} */
 
     /** @{
        Return the PointLevel instance that contains this section's data
     **/
-    inline Property::PointLevel& properties() noexcept;
-    inline const Property::PointLevel& properties() const noexcept;
+    inline Property::PointLevel& properties();
+    inline const Property::PointLevel& properties() const;
     /** @} */
     ////////////////////////////////////////////////////////////////////////////////
     //
@@ -87,7 +97,7 @@ class Section: public std::enable_shared_from_this<Section>
     /**
      * Return true if the both sections have the same points, diameters and perimeters
      */
-    bool hasSameShape(const Section& other) const noexcept;
+    bool hasSameShape(const Section& other) const;
 
     /**
        Return a vector of children IDs
@@ -113,8 +123,12 @@ class Section: public std::enable_shared_from_this<Section>
 
   private:
     friend class Morphology;
+    friend bool _checkDuplicatePoint(const std::shared_ptr<Section>& parent,
+                                     const std::shared_ptr<Section>& current);
+    friend void modifiers::two_points_sections(Morphology& morpho, size_t n_threads);
+    friend void modifiers::no_duplicate_point(Morphology& morpho, size_t n_threads);
 
-    Section(Morphology*, unsigned int id, SectionType type, const Property::PointLevel&);
+    Section(Morphology*, unsigned int id, SectionType type, Property::PointLevel);
     Section(Morphology*, unsigned int id, const morphio::Section& section);
     Section(Morphology*, unsigned int id, const Section&);
 
@@ -129,10 +143,56 @@ class Section: public std::enable_shared_from_this<Section>
     **/
     Morphology* getOwningMorphologyOrThrow() const;
 
+    /**
+     * Copy the point data from `source_`, if not done yet. Concurrent calls are safe: the
+     * data is copied once, and `source_` is kept as is.
+     */
+    inline void materialize() const;
+    void copySource() const;
+
+    /**
+     * Copy the point data from `source_`, if not done yet, and release it. Called before
+     * handing out a mutable reference to the data, so the section is also marked modified.
+     */
+    inline void detachSource();
+
+    /** Return the number of points, without copying the point data */
+    size_t pointCount() const noexcept;
+
+    /** Return the point `i`, without copying the point data */
+    const Point& pointAt(size_t i) const noexcept;
+
+    /** Return the range of the points of the section in `source_` */
+    SectionRange sourceRange() const noexcept;
+
+    /**
+     * Keep only the points [begin, end) of the section. Point data still in `source_` is
+     * copied from that offset, without copying the dropped points first.
+     */
+    void keepPoints(size_t begin, size_t end);
+
+    /** Keep only the first and last points of the section, read from `source_` if there */
+    void keepEnds();
+
     Morphology* morphology_;
-    Property::PointLevel point_properties_;
+    /** The point data, mutable so that it can be copied from `source_` on first access */
+    mutable Property::PointLevel point_properties_;
     uint32_t id_;
     SectionType section_type_;
+
+    /**
+     * The read-only properties holding the point data of a section copied from a
+     * morphio::Section, at position `sourcePosition_`, until the data is first accessed
+     * mutably. Null once the data is only in `point_properties_`.
+     */
+    std::shared_ptr<const Property::Properties> source_;
+    uint32_t sourcePosition_ = 0;
+    mutable std::once_flag copied_;
+
+    /** Bumped by every change of the point data, to tell whether a snapshot is still valid */
+    uint64_t version_ = 0;
+    /** True once a mutable reference to the point data was handed out */
+    bool exposed_ = false;
 };
 
 std::ostream& operator<<(std::ostream&, const std::shared_ptr<Section>&);
@@ -149,38 +209,59 @@ inline const SectionType& Section::type() const noexcept {
     return section_type_;
 }
 
-inline std::vector<Point>& Section::points() noexcept {
+inline std::vector<Point>& Section::points() {
+    detachSource();
     return point_properties_._points;
 }
 
-inline const std::vector<Point>& Section::points() const noexcept {
+inline const std::vector<Point>& Section::points() const {
+    materialize();
     return point_properties_._points;
 }
 
-inline std::vector<morphio::floatType>& Section::diameters() noexcept {
+inline std::vector<morphio::floatType>& Section::diameters() {
+    detachSource();
     return point_properties_._diameters;
 }
 
-inline const std::vector<morphio::floatType>& Section::diameters() const noexcept {
+inline const std::vector<morphio::floatType>& Section::diameters() const {
+    materialize();
     return point_properties_._diameters;
 }
 
-inline std::vector<morphio::floatType>& Section::perimeters() noexcept {
+inline std::vector<morphio::floatType>& Section::perimeters() {
+    detachSource();
     return point_properties_._perimeters;
 }
 
-inline const std::vector<morphio::floatType>& Section::perimeters() const noexcept {
+inline const std::vector<morphio::floatType>& Section::perimeters() const {
+    materialize();
     return point_properties_._perimeters;
 }
 
-inline Property::PointLevel& Section::properties() noexcept {
+inline Property::PointLevel& Section::properties() {
+    detachSource();
     return point_properties_;
 }
 
-inline const Property::PointLevel& Section::properties() const noexcept {
+inline const Property::PointLevel& Section::properties() const {
+    materialize();
     return point_properties_;
 }
 
+inline void Section::materialize() const {
+    if (source_) {
+        std::call_once(copied_, [this]() { copySource(); });
+    }
+}
+
+inline void Section::detachSource() {
+    materialize();
+    source_.reset();
+    ++version_;
+    exposed_ = true;
+}
+
 }  // namespace mut
 }  // namespace morphio
 
@@ -1,6 +1,11 @@
+#pragma once
+
+#include <highfive/H5File.hpp>
 #include <morphio/mut/morphology.h>
 
 namespace morphio {
+class Collection;
+
 namespace mut {
 namespace writer {
 /** Save morphology in SWC format */
@@ -9,6 +14,45 @@ void swc(const Morphology& morphology, const std::string& filename);
 void asc(const Morphology& morphology, const std::string& filename);
 /** Save morphology in H5 format */
 void h5(const Morphology& morphology, const std::string& filename);
+
+/**
+ * Write many morphologies into a single HDF5 container.
+ *
+ * Each morphology is stored as a group, with the same layout as a single H5 file,
+ * so that the container can be read with `morphio::Collection`. Datasets use the
+ * contiguous layout and are allocated in the order the morphologies are appended,
+ * aligned to 8 bytes. Loading the morphologies in the order they were appended,
+ * e.g. through `Collection::load_unordered`, therefore reads the file sequentially.
+ *
+ * Note: This API is 'experimental', meaning it might change in the future.
+ */
+class ContainerWriter
+{
+  public:
+    /** Create the container `filename`, overwriting any existing file */
+    explicit ContainerWriter(const std::string& filename);
+
+    /** Append `morphology` as the group `name` */
+    void append(const std::string& name, const Morphology& morphology);
+
+    /**
+     * Append the morphologies `names` of `collection`.
+     *
+     * If `order` is not empty, it gives the order in which the morphologies will be
+     * accessed: `names[order[0]]` is written first, then `names[order[1]]`, etc.
+     *
+     * @throw WriterError if `order` is not a permutation of the indices of `names`
+     */
+    void append(const Collection& collection,
+                const std::vector<std::string>& names,
+                const std::vector<size_t>& order = {});
+
+    /** Flush the written data to disk */
+    void flush();
+
+  private:
+    HighFive::File _file;
+};
 }  // namespace writer
 }  // end namespace mut
 }  // end namespace morphio
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>  // std::size_t
+#include <cstdlib>  // std::free
+#include <new>      // std::bad_alloc
+#include <vector>
+
+#ifdef _WIN32
+#include <malloc.h>  // _aligned_malloc
+#endif
+
+#include <morphio/vector_types.h>
+
+namespace morphio {
+
+/** Allocator returning memory aligned to `Alignment` bytes, e.g. for vectorized loops */
+template <typename T, std::size_t Alignment = 64>
+class AlignedAllocator
+{
+  public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>& /*other*/) noexcept {}
+
+    T* allocate(std::size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        if (n > static_cast<std::size_t>(-1) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        void* ptr = nullptr;
+#ifdef _WIN32
+        ptr = _aligned_malloc(n * sizeof(T), Alignment);
+#else
+        if (posix_memalign(&ptr, Alignment, n * sizeof(T)) != 0) {
+            ptr = nullptr;
+        }
+#endif
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, std::size_t /*n*/) noexcept {
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>& /*other*/) const noexcept {
+        return true;
+    }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>& /*other*/) const noexcept {
+        return false;
+    }
+};
+
+/** A vector whose data is aligned to a cache line */
+template <typename T>
+using aligned_vector = std::vector<T, AlignedAllocator<T>>;
+
+/**
+ * Spans over the coordinates and diameters of consecutive points, in structure-of-arrays
+ * layout: the i-th point is (x[i], y[i], z[i]) with diameter diameters[i].
+ */
+struct PointsSoAView {
+    range<const floatType> x;
+    range<const floatType> y;
+    range<const floatType> z;
+    range<const floatType> diameters;
+
+    std::size_t size() const noexcept {
+        return x.size();
+    }
+
+    bool empty() const noexcept {
+        return x.empty();
+    }
+
+    /** Return the view of the points [start, end) */
+    PointsSoAView subview(std::size_t start, std::size_t end) const noexcept {
+        return {x.subspan(start, end - start),
+                y.subspan(start, end - start),
+                z.subspan(start, end - start),
+                diameters.empty() ? diameters : diameters.subspan(start, end - start)};
+    }
+};
+
+namespace Property {
+
+/**
+ * A copy of the points and diameters in structure-of-arrays layout, with every array
+ * aligned to 64 bytes, so that loops over the coordinates can be vectorized.
+ */
+struct PointsSoA {
+    aligned_vector<floatType> _x;
+    aligned_vector<floatType> _y;
+    aligned_vector<floatType> _z;
+    aligned_vector<floatType> _diameters;
+
+    PointsSoA() = default;
+    PointsSoA(const std::vector<morphio::Point>& points, const std::vector<floatType>& diameters);
+
+    PointsSoAView view() const noexcept {
+        return {{_x.data(), _x.size()},
+                {_y.data(), _y.size()},
+                {_z.data(), _z.size()},
+                {_diameters.data(), _diameters.size()}};
+    }
+};
+
+}  // namespace Property
+}  // namespace morphio
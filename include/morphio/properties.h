@@ -3,9 +3,13 @@
 #include <cstdint>  // uint32_t
 
 #include <array>
+#include <atomic>
 #include <map>
+#include <memory>  // std::unique_ptr
+#include <mutex>
 #include <vector>
 
+#include <morphio/points_soa.h>
 #include <morphio/types.h>
 #include <morphio/vector_types.h>
 #include <morphio/version.h>
@@ -69,21 +73,192 @@ struct PointLevel {
                std::vector<Diameter::Type> diameters,
                std::vector<Perimeter::Type> perimeters = {});
     PointLevel(const PointLevel& data);
+    PointLevel(PointLevel&& data) noexcept = default;
     PointLevel(const PointLevel& data, SectionRange range);
     PointLevel& operator=(const PointLevel& other);
+    PointLevel& operator=(PointLevel&& other) noexcept = default;
+};
+
+/**
+ * A value computed on first access, in a thread safe way.
+ *
+ * Copying a LazyValue yields an empty one: the value is derived from data owned by
+ * the enclosing object, and will be computed again for the copy if needed. The cached
+ * value is never invalidated; it is only meant for data that is not modified once it
+ * is shared, like the Properties of an immutable morphology.
+ */
+template <typename T>
+class LazyValue
+{
+  public:
+    LazyValue() = default;
+    LazyValue(const LazyValue& /*other*/) noexcept {}
+    LazyValue& operator=(const LazyValue& other) noexcept {
+        if (this != &other) {
+            reset();
+        }
+        return *this;
+    }
+
+    /** Drop the value, so that the next access computes it again */
+    void reset() noexcept {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _ready.store(false, std::memory_order_relaxed);
+        _value.reset();
+    }
+
+    /** Return the value, calling `compute()` to build it on first access */
+    template <typename F>
+    const T& get(const F& compute) const {
+        if (!_ready.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (!_ready.load(std::memory_order_relaxed)) {
+                _value.reset(new T(compute()));
+                _ready.store(true, std::memory_order_release);
+            }
+        }
+        return *_value;
+    }
+
+  private:
+    mutable std::mutex _mutex;
+    mutable std::unique_ptr<T> _value;
+    mutable std::atomic<bool> _ready{false};
+};
+
+/**
+ * The children of every section, in compressed sparse row layout.
+ *
+ * The children of section `i` are `_ids[_offsets[i]:_offsets[i + 1]]`, sorted by ID;
+ * the root sections are stored separately in `_roots`.
+ */
+struct ChildrenTable {
+    std::vector<uint32_t> _offsets;
+    std::vector<uint32_t> _ids;
+    std::vector<uint32_t> _roots;
+
+    ChildrenTable() = default;
+    /**
+     * Build the table from the (offset, parent index) pairs of the sections.
+     *
+     * @throw RawDataError if a parent is out of bounds or a section does not lead to a root
+     */
+    explicit ChildrenTable(const std::vector<Section::Type>& sections);
+
+    /** Return the IDs of the children of `sectionId`, empty if the ID is unknown */
+    range<const uint32_t> children(uint32_t sectionId) const noexcept {
+        if (static_cast<size_t>(sectionId) + 1 >= _offsets.size()) {
+            return {};
+        }
+        return {_ids.data() + _offsets[sectionId], _offsets[sectionId + 1] - _offsets[sectionId]};
+    }
+
+    /** Return the IDs of the root sections */
+    range<const uint32_t> roots() const noexcept {
+        return {_roots.data(), _roots.size()};
+    }
+
+    /** Return the table as a map from parent ID to children IDs, -1 being the roots' parent */
+    std::map<int, std::vector<unsigned int>> toMap() const;
+
+    /**
+     * Build the table from a map as returned by toMap().
+     *
+     * @throw RawDataError unless every section is reached exactly once from the roots
+     */
+    static ChildrenTable fromMap(const std::map<int, std::vector<unsigned int>>& children);
+
+    bool operator==(const ChildrenTable& other) const;
+    bool operator!=(const ChildrenTable& other) const;
+
+  private:
+    /** Throw a RawDataError unless every section is reached exactly once from the roots */
+    void checkTree() const;
+};
+
+/**
+ * The depth first and breadth first orders of the sections, derived from a ChildrenTable.
+ *
+ * The subtree of a section is the contiguous range [entry, exit) of the depth first order,
+ * which gives O(1) ancestry tests.
+ */
+struct TraversalOrders {
+    /** Section IDs in depth first (pre-)order, the trees of the roots following each other */
+    std::vector<uint32_t> _depthFirst;
+    /** Section IDs in breadth first order, starting with all the roots */
+    std::vector<uint32_t> _breadthFirst;
+    /** Position of every section in `_depthFirst` */
+    std::vector<uint32_t> _depthFirstPosition;
+    /** Number of sections in the subtree of every section, the section itself included */
+    std::vector<uint32_t> _subtreeSize;
+    /** True if the section IDs follow the depth first order, i.e. `_depthFirst[i] == i` */
+    bool _isDepthFirstLayout = true;
+
+    TraversalOrders() = default;
+    explicit TraversalOrders(const ChildrenTable& children);
+
+    /** Return the position of `sectionId` in the depth first order */
+    uint32_t entry(uint32_t sectionId) const noexcept {
+        return _depthFirstPosition[sectionId];
+    }
+
+    /** Return the position following the subtree of `sectionId` in the depth first order */
+    uint32_t exit(uint32_t sectionId) const noexcept {
+        return _depthFirstPosition[sectionId] + _subtreeSize[sectionId];
+    }
+
+    /** Return true if `sectionId` is a strict descendant of `ancestorId` */
+    bool isDescendant(uint32_t sectionId, uint32_t ancestorId) const noexcept {
+        return entry(ancestorId) < entry(sectionId) && entry(sectionId) < exit(ancestorId);
+    }
+
+    /** Return the IDs of the subtree starting at `sectionId`, in depth first order */
+    range<const uint32_t> depthFirst(uint32_t sectionId) const noexcept {
+        return {_depthFirst.data() + entry(sectionId), _subtreeSize[sectionId]};
+    }
 };
 
 /** Information that is available at the section level (section type, parent section) */
 struct SectionLevel {
     std::vector<Section::Type> _sections;
     std::vector<SectionType::Type> _sectionTypes;
-    std::map<int, std::vector<unsigned int>> _children;
+    ChildrenTable _children;
+
+    /** Replace `_children`, dropping the values derived from the previous table */
+    void setChildren(ChildrenTable children);
+
+    /** Return `_children` as a map, built on first access */
+    const std::map<int, std::vector<unsigned int>>& connectivity() const;
+
+    /** Return the traversal orders of the sections, built on first access */
+    const TraversalOrders& traversal() const;
 
     bool operator==(const SectionLevel& other) const;
     bool operator!=(const SectionLevel& other) const;
 
     // Like operator!= but with logLevel argument
     bool diff(const SectionLevel& other, LogLevel logLevel) const;
+
+  private:
+    LazyValue<std::map<int, std::vector<unsigned int>>> _connectivity;
+    LazyValue<TraversalOrders> _traversal;
+};
+
+/**
+ * The path distance of every section point, i.e. the length of the path along the
+ * sections from the first point of its root section.
+ */
+struct PathDistances {
+    /** Path distance of every point of `PointLevel::_points` */
+    std::vector<floatType> _points;
+    /** Path distance of the first point of every section */
+    std::vector<floatType> _sectionStarts;
+
+    PathDistances() = default;
+    /** Compute the path distances in one depth first pass over the sections */
+    PathDistances(const std::vector<morphio::Point>& points,
+                  const std::vector<Section::Type>& sections,
+                  const TraversalOrders& traversal);
 };
 
 /**
@@ -112,11 +287,21 @@ struct MitochondriaPointLevel {
 /** Information that is available at the mitochondrial section level (parent section) */
 struct MitochondriaSectionLevel {
     std::vector<Section::Type> _sections;
-    std::map<int, std::vector<unsigned int>> _children;
+    ChildrenTable _children;
+
+    /** Return `_children` as a map, built on first access */
+    const std::map<int, std::vector<unsigned int>>& connectivity() const;
+
+    /** Return the traversal orders of the sections, built on first access */
+    const TraversalOrders& traversal() const;
 
     bool diff(const MitochondriaSectionLevel& other, LogLevel logLevel) const;
     bool operator==(const MitochondriaSectionLevel& other) const;
     bool operator!=(const MitochondriaSectionLevel& other) const;
+
+  private:
+    LazyValue<std::map<int, std::vector<unsigned int>>> _connectivity;
+    LazyValue<TraversalOrders> _traversal;
 };
 
 /** Properties that are available for morphio::DendriticSpine */
@@ -235,8 +420,30 @@ struct Properties {
     const morphio::SomaType& somaType() const noexcept {
         return _cellLevel._somaType;
     }
+    /** Return the children table of the sections of kind T (Section or MitoSection) */
+    template <typename T>
+    const ChildrenTable& children() const noexcept;
+
+    /** Return the children of the sections of kind T as a map, built on first access */
+    template <typename T>
+    const std::map<int32_t, std::vector<uint32_t>>& connectivity() const;
+
+    /** Return the traversal orders of the sections of kind T, built on first access */
     template <typename T>
-    const std::map<int32_t, std::vector<uint32_t>>& children() const noexcept;
+    const TraversalOrders& traversal() const;
+
+    /** Return the path distances of the section points, built on first access */
+    const PathDistances& pathDistances() const;
+
+    /**
+     * Return the points and diameters of `_pointLevel` in structure-of-arrays layout, built on
+     * first access
+     */
+    const PointsSoA& pointsSoA() const;
+
+  private:
+    LazyValue<PathDistances> _pathDistances;
+    LazyValue<PointsSoA> _pointsSoA;
 };
 
 
@@ -266,16 +473,35 @@ INSTANTIATE_TEMPLATE_GET(SectionType, _sectionLevel._sectionTypes)
 #undef INSTANTIATE_TEMPLATE_GET
 
 template <>
-inline const std::map<int32_t, std::vector<uint32_t>>& Properties::children<Section>() const
-    noexcept {
+inline const ChildrenTable& Properties::children<Section>() const noexcept {
     return _sectionLevel._children;
 }
 
 template <>
-inline const std::map<int32_t, std::vector<uint32_t>>& Properties::children<MitoSection>() const
-    noexcept {
+inline const ChildrenTable& Properties::children<MitoSection>() const noexcept {
     return _mitochondriaSectionLevel._children;
 }
 
+template <>
+inline const std::map<int32_t, std::vector<uint32_t>>& Properties::connectivity<Section>() const {
+    return _sectionLevel.connectivity();
+}
+
+template <>
+inline const std::map<int32_t, std::vector<uint32_t>>& Properties::connectivity<MitoSection>()
+    const {
+    return _mitochondriaSectionLevel.connectivity();
+}
+
+template <>
+inline const TraversalOrders& Properties::traversal<Section>() const {
+    return _sectionLevel.traversal();
+}
+
+template <>
+inline const TraversalOrders& Properties::traversal<MitoSection>() const {
+    return _mitochondriaSectionLevel.traversal();
+}
+
 }  // namespace Property
 }  // namespace morphio
@@ -11,8 +11,8 @@
 namespace morphio {
 
 using upstream_iterator = upstream_iterator_t<Section>;
-using breadth_iterator = breadth_iterator_t<Section, Morphology>;
-using depth_iterator = depth_iterator_t<Section, Morphology>;
+using breadth_iterator = section_order_iterator_t<Section>;
+using depth_iterator = section_order_iterator_t<Section>;
 
 /**
  * A class to represent a morphological section.
@@ -41,7 +41,7 @@ class Section: public SectionBase<Section>
   public:
     /// Depth first iterator
     depth_iterator depth_begin() const {
-        return depth_iterator(*this);
+        return depth_iterator(properties_, subtreeIds());
     }
     depth_iterator depth_end() const {
         return depth_iterator();
@@ -49,7 +49,7 @@ class Section: public SectionBase<Section>
 
     /// Breadth first iterator
     breadth_iterator breadth_begin() const {
-        return breadth_iterator(*this);
+        return breadth_iterator(properties_, breadthFirstIds());
     }
     breadth_iterator breadth_end() const {
         return breadth_iterator();
@@ -90,6 +90,43 @@ class Section: public SectionBase<Section>
         return get<Property::Perimeter>();
     }
 
+    /**
+     * Return a view to the point coordinates of this section and of all its descendants
+     *
+     * @throw MorphioError if the sections are not stored in depth first order, as the
+     * points of the subtree are not contiguous then. The morphologies built by
+     * mut::Morphology, and thus read from SWC or ASC, are stored in depth first order.
+     **/
+    range<const Point> subtreePoints() const {
+        return getSubtree<Property::Point>();
+    }
+
+    /**
+     * Return a view to the point diameters of this section and of all its descendants
+     *
+     * @throw MorphioError if the sections are not stored in depth first order
+     **/
+    range<const floatType> subtreeDiameters() const {
+        return getSubtree<Property::Diameter>();
+    }
+
+    /**
+     * Return this section's points and diameters in structure-of-arrays layout, see
+     * Morphology::pointsSoA()
+     **/
+    PointsSoAView pointsSoA() const {
+        return properties_->pointsSoA().view().subview(range_.first, range_.second);
+    }
+
+    /**
+     * Return the path distance of every point of this section, i.e. the length of the
+     * path from the first point of the root section, see Morphology::pathDistances()
+     **/
+    range<const floatType> pathDistances() const {
+        const auto& distances = properties_->pathDistances()._points;
+        return {distances.data() + range_.first, range_.second - range_.first};
+    }
+
     /// Return the morphological type of this section (dendrite, axon, ...)
     SectionType type() const {
         return properties_->get<Property::SectionType>()[id_];
@@ -107,6 +144,7 @@ class Section: public SectionBase<Section>
     friend class mut::Section;
     friend Section Morphology::section(uint32_t) const;
     friend class SectionBase<Section>;
+    friend class section_order_iterator_t<Section>;
 
   protected:
     Section(uint32_t id, const std::shared_ptr<Property::Properties>& properties)
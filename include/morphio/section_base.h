@@ -45,6 +45,22 @@ class SectionBase
      */
     std::vector<T> children() const;
 
+    /**
+     * Return the IDs of the children sections, sorted, without any allocation
+     */
+    range<const uint32_t> childrenIds() const noexcept;
+
+    /**
+     * Return true if this section is in the subtree of `ancestor`, `ancestor` itself
+     * excluded. This takes constant time.
+     */
+    bool isDescendantOf(const T& ancestor) const;
+
+    /**
+     * Return the IDs of this section and of all its descendants, in depth first order
+     */
+    range<const uint32_t> subtreeIds() const;
+
     /** Return the ID of this section. */
     uint32_t id() const noexcept { return id_; }
 
@@ -54,6 +70,19 @@ class SectionBase
     template <typename Property>
     range<const typename Property::Type> get() const;
 
+    /**
+     * Return the values of `Property` for the points of this section and of all its
+     * descendants.
+     *
+     * @throw MorphioError if the sections are not stored in depth first order, as the
+     * points of the subtree are not contiguous then
+     */
+    template <typename Property>
+    range<const typename Property::Type> getSubtree() const;
+
+    /** Return the IDs of the subtree starting at this section, in breadth first order */
+    std::shared_ptr<const std::vector<uint32_t>> breadthFirstIds() const;
+
     uint32_t id_ = 0;
     SectionRange range_;
     std::shared_ptr<Property::Properties> properties_;
@@ -124,26 +153,69 @@ T SectionBase<T>::parent() const {
 
 template <typename T>
 std::vector<T> SectionBase<T>::children() const {
-    const auto& section_children = properties_->children<typename T::SectionId>();
+    const auto ids = childrenIds();
 
-    if (section_children.empty()) {
-        return {};
+    std::vector<T> result;
+    result.reserve(ids.size());
+    for (uint32_t id : ids) {
+        result.push_back(T(id, properties_));
     }
 
-    const auto it = section_children.find(static_cast<int>(id_));
-    if (it == section_children.end()) {
-        return {};
+    return result;
+}
+
+template <typename T>
+range<const uint32_t> SectionBase<T>::childrenIds() const noexcept {
+    return properties_->children<typename T::SectionId>().children(id_);
+}
+
+template <typename T>
+bool SectionBase<T>::isDescendantOf(const T& ancestor) const {
+    return ancestor.properties_ == properties_ &&
+           properties_->traversal<typename T::SectionId>().isDescendant(id_, ancestor.id_);
+}
+
+template <typename T>
+range<const uint32_t> SectionBase<T>::subtreeIds() const {
+    return properties_->traversal<typename T::SectionId>().depthFirst(id_);
+}
+
+template <typename T>
+template <typename TProperty>
+range<const typename TProperty::Type> SectionBase<T>::getSubtree() const {
+    const auto& traversal = properties_->traversal<typename T::SectionId>();
+    if (!traversal._isDepthFirstLayout) {
+        throw MorphioError(
+            "The points of a subtree are only contiguous when the sections are stored in "
+            "depth first order (section id=" +
+            std::to_string(id_) + ")");
     }
 
-    std::vector<T> result;
-    const std::vector<uint32_t> children = it->second;
-    result.reserve(children.size());
-    for (uint32_t id : children) {
-        result.push_back(T(id, properties_));
+    const auto& data = properties_->get<TProperty>();
+    if (data.empty()) {
+        return {};
     }
 
-    return result;
+    // In depth first layout, the subtree ends right before the section following it
+    const auto& sections = properties_->get<typename T::SectionId>();
+    const uint32_t next = traversal.exit(id_);
+    const size_t end = next == sections.size() ? data.size()
+                                               : static_cast<size_t>(sections[next][0]);
+    return {data.data() + range_.first, end - range_.first};
 }
 
+template <typename T>
+std::shared_ptr<const std::vector<uint32_t>> SectionBase<T>::breadthFirstIds() const {
+    const auto& children = properties_->children<typename T::SectionId>();
+
+    auto ids = std::make_shared<std::vector<uint32_t>>();
+    ids->reserve(subtreeIds().size());
+    ids->push_back(id_);
+    for (size_t i = 0; i < ids->size(); ++i) {
+        const auto sectionChildren = children.children((*ids)[i]);
+        ids->insert(ids->end(), sectionChildren.begin(), sectionChildren.end());
+    }
+    return ids;
+}
 
 }  // namespace morphio
@@ -4,10 +4,12 @@
 #include <deque>      // std::deque
 #include <iterator>   // std::back_inserter / std::front_inserter
 #include <memory>     // std::shared_ptr
+#include <utility>    // std::move
 #include <vector>     // std::vector
 
 #include <morphio/exceptions.h>
 #include <morphio/types.h>
+#include <morphio/vector_types.h>
 
 namespace detail {
 
@@ -107,6 +109,62 @@ class depth_iterator_t
     std::deque<SectionT> deque_;
 };
 
+/**
+ * Iterator over sections of an immutable morphology, following an array of section IDs.
+ *
+ * The depth first and breadth first orders of a whole morphology are computed once and
+ * cached in its Properties, so that iterating is a linear scan of an array.
+ */
+template <typename SectionT>
+class section_order_iterator_t
+{
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = SectionT;
+    using difference_type = std::ptrdiff_t;
+    using pointer = SectionT*;
+    using reference = SectionT&;
+
+    /** Holds the current section, so that operator-> can return a pointer to it */
+    class arrow_proxy
+    {
+      public:
+        explicit arrow_proxy(SectionT section)
+            : section_(std::move(section)) {}
+        SectionT const* operator->() const noexcept {
+            return &section_;
+        }
+
+      private:
+        SectionT section_;
+    };
+
+    section_order_iterator_t() = default;
+
+    /** Iterate over `ids`, an array that outlives the iterator, e.g. cached in `properties` */
+    inline section_order_iterator_t(std::shared_ptr<Property::Properties> properties,
+                                    range<const uint32_t> ids);
+
+    /** Iterate over `ids`, shared with the copies of this iterator */
+    inline section_order_iterator_t(std::shared_ptr<Property::Properties> properties,
+                                    std::shared_ptr<const std::vector<uint32_t>> ids);
+
+    inline SectionT operator*() const;
+    inline arrow_proxy operator->() const;
+
+    inline section_order_iterator_t& operator++();
+    inline section_order_iterator_t operator++(int);
+
+    inline bool operator==(const section_order_iterator_t& other) const noexcept;
+    inline bool operator!=(const section_order_iterator_t& other) const noexcept;
+
+  private:
+    std::shared_ptr<Property::Properties> properties_;
+    std::shared_ptr<const std::vector<uint32_t>> storage_;
+    const uint32_t* current_ = nullptr;
+    const uint32_t* end_ = nullptr;
+};
+
 template <typename SectionT>
 class upstream_iterator_t
 {
@@ -268,6 +326,67 @@ inline bool depth_iterator_t<SectionT, MorphologyT>::operator!=(
     return !(*this == other);
 }
 
+// section_order_iterator_t class definition
+
+template <typename SectionT>
+inline section_order_iterator_t<SectionT>::section_order_iterator_t(
+    std::shared_ptr<Property::Properties> properties, range<const uint32_t> ids)
+    : properties_(std::move(properties))
+    , current_(ids.data())
+    , end_(ids.data() + ids.size()) {}
+
+template <typename SectionT>
+inline section_order_iterator_t<SectionT>::section_order_iterator_t(
+    std::shared_ptr<Property::Properties> properties,
+    std::shared_ptr<const std::vector<uint32_t>> ids)
+    : properties_(std::move(properties))
+    , storage_(std::move(ids))
+    , current_(storage_->data())
+    , end_(storage_->data() + storage_->size()) {}
+
+template <typename SectionT>
+inline SectionT section_order_iterator_t<SectionT>::operator*() const {
+    return SectionT(*current_, properties_);
+}
+
+template <typename SectionT>
+inline typename section_order_iterator_t<SectionT>::arrow_proxy
+section_order_iterator_t<SectionT>::operator->() const {
+    return arrow_proxy(**this);
+}
+
+template <typename SectionT>
+inline section_order_iterator_t<SectionT>& section_order_iterator_t<SectionT>::operator++() {
+    if (current_ == end_) {
+        throw MorphioError("Can't iterate past the end");
+    }
+    ++current_;
+    return *this;
+}
+
+template <typename SectionT>
+inline section_order_iterator_t<SectionT> section_order_iterator_t<SectionT>::operator++(int) {
+    section_order_iterator_t ret(*this);
+    ++(*this);
+    return ret;
+}
+
+template <typename SectionT>
+inline bool section_order_iterator_t<SectionT>::operator==(
+    const section_order_iterator_t& other) const noexcept {
+    // All exhausted iterators compare equal to the default constructed end iterator
+    if (current_ == end_ || other.current_ == other.end_) {
+        return current_ == end_ && other.current_ == other.end_;
+    }
+    return current_ == other.current_;
+}
+
+template <typename SectionT>
+inline bool section_order_iterator_t<SectionT>::operator!=(
+    const section_order_iterator_t& other) const noexcept {
+    return !(*this == other);
+}
+
 // upstream_iterator_t class definition
 
 template <typename SectionT>
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <cstdint>   // uint32_t
+#include <iterator>  // std::random_access_iterator_tag
+#include <string>    // std::to_string
+
+#include <morphio/exceptions.h>
+#include <morphio/properties.h>
+#include <morphio/types.h>
+#include <morphio/vector_types.h>
+
+namespace morphio {
+
+/**
+ * A non-owning handle to a section of an immutable morphology.
+ *
+ * A SectionView offers the same read API as morphio::Section, but it only holds the
+ * section ID and a raw pointer to the morphological data: creating, copying and
+ * navigating views never allocates and never touches a reference count. This makes
+ * it suited to walking the same morphology from many threads.
+ *
+ * The view does not keep the data alive: it must not outlive the morphio::Morphology
+ * (or the last of its copies) that it comes from.
+ */
+class SectionView
+{
+  public:
+    bool operator==(const SectionView& other) const noexcept {
+        return other.id_ == id_ && other.properties_ == properties_;
+    }
+    bool operator!=(const SectionView& other) const noexcept {
+        return !(*this == other);
+    }
+
+    /** Return the ID of this section. */
+    uint32_t id() const noexcept {
+        return id_;
+    }
+
+    /** Return true if this section is a root section (parent ID == -1) */
+    bool isRoot() const noexcept {
+        return sections()[id_][1] == -1;
+    }
+
+    /**
+     * Return the parent section of this section
+     *
+     * @throw MissingParentError is the section doesn't have a parent.
+     */
+    SectionView parent() const {
+        if (isRoot()) {
+            throw MissingParentError(
+                "Cannot call SectionView::parent() on a root node (section id=" +
+                std::to_string(id_) + ").");
+        }
+        return {static_cast<uint32_t>(sections()[id_][1]), properties_};
+    }
+
+    /** Return the children sections */
+    inline SectionViewRange children() const noexcept;
+
+    /** Return the IDs of the children sections */
+    range<const uint32_t> childrenIds() const noexcept {
+        return properties_->children<Property::Section>().children(id_);
+    }
+
+    /** Return true if this section is in the subtree of `ancestor`, `ancestor` excluded */
+    bool isDescendantOf(const SectionView& ancestor) const {
+        return ancestor.properties_ == properties_ &&
+               properties_->traversal<Property::Section>().isDescendant(id_, ancestor.id_);
+    }
+
+    /** Return the IDs of this section and of all its descendants, in depth first order */
+    range<const uint32_t> subtreeIds() const {
+        return properties_->traversal<Property::Section>().depthFirst(id_);
+    }
+
+    /** Return a view to this section's point coordinates */
+    range<const Point> points() const noexcept {
+        return get<Property::Point>();
+    }
+
+    /** Return a view to this section's point diameters */
+    range<const floatType> diameters() const noexcept {
+        return get<Property::Diameter>();
+    }
+
+    /** Return a view to this section's point perimeters */
+    range<const floatType> perimeters() const noexcept {
+        return get<Property::Perimeter>();
+    }
+
+    /** Return this section's points and diameters in structure-of-arrays layout */
+    PointsSoAView pointsSoA() const {
+        const auto range_ = pointRange();
+        return properties_->pointsSoA().view().subview(range_.first, range_.second);
+    }
+
+    /** Return the path distance of every point of this section, see Section::pathDistances() */
+    range<const floatType> pathDistances() const {
+        const auto& distances = properties_->pathDistances()._points;
+        const auto range_ = pointRange();
+        return {distances.data() + range_.first, range_.second - range_.first};
+    }
+
+    /** Return the morphological type of this section (dendrite, axon, ...) */
+    SectionType type() const noexcept {
+        return properties_->get<Property::SectionType>()[id_];
+    }
+
+  private:
+    SectionView(uint32_t id, const Property::Properties* properties) noexcept
+        : id_(id)
+        , properties_(properties) {}
+
+    const std::vector<Property::Section::Type>& sections() const noexcept {
+        return properties_->get<Property::Section>();
+    }
+
+    SectionRange pointRange() const noexcept {
+        const auto& sections_ = sections();
+        const auto start = static_cast<size_t>(sections_[id_][0]);
+        const size_t end = id_ + 1 == sections_.size()
+                               ? properties_->get<Property::Point>().size()
+                               : static_cast<size_t>(sections_[id_ + 1][0]);
+        return {start, end};
+    }
+
+    template <typename TProperty>
+    range<const typename TProperty::Type> get() const noexcept {
+        const auto& data = properties_->get<TProperty>();
+        if (data.empty()) {
+            return {};
+        }
+        const auto range_ = pointRange();
+        return {data.data() + range_.first, range_.second - range_.first};
+    }
+
+    uint32_t id_ = 0;
+    const Property::Properties* properties_ = nullptr;
+
+    friend class Morphology;
+    friend class SectionViewRange;
+};
+
+/** A range of sections, e.g. the children of a section, given by their IDs */
+class SectionViewRange
+{
+  public:
+    class const_iterator
+    {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = SectionView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = SectionView;
+
+        const_iterator(const uint32_t* id, const Property::Properties* properties) noexcept
+            : id_(id)
+            , properties_(properties) {}
+
+        SectionView operator*() const noexcept {
+            return {*id_, properties_};
+        }
+        SectionView operator[](difference_type n) const noexcept {
+            return {id_[n], properties_};
+        }
+        const_iterator& operator++() noexcept {
+            ++id_;
+            return *this;
+        }
+        const_iterator operator++(int) noexcept {
+            const_iterator tmp(*this);
+            ++id_;
+            return tmp;
+        }
+        const_iterator& operator--() noexcept {
+            --id_;
+            return *this;
+        }
+        const_iterator operator--(int) noexcept {
+            const_iterator tmp(*this);
+            --id_;
+            return tmp;
+        }
+        const_iterator& operator+=(difference_type n) noexcept {
+            id_ += n;
+            return *this;
+        }
+        const_iterator& operator-=(difference_type n) noexcept {
+            id_ -= n;
+            return *this;
+        }
+        const_iterator operator+(difference_type n) const noexcept {
+            return {id_ + n, properties_};
+        }
+        const_iterator operator-(difference_type n) const noexcept {
+            return {id_ - n, properties_};
+        }
+        difference_type operator-(const const_iterator& other) const noexcept {
+            return id_ - other.id_;
+        }
+        bool operator==(const const_iterator& other) const noexcept {
+            return id_ == other.id_;
+        }
+        bool operator!=(const const_iterator& other) const noexcept {
+            return id_ != other.id_;
+        }
+        bool operator<(const const_iterator& other) const noexcept {
+            return id_ < other.id_;
+        }
+
+      private:
+        const uint32_t* id_;
+        const Property::Properties* properties_;
+    };
+
+    SectionViewRange(range<const uint32_t> ids, const Property::Properties* properties) noexcept
+        : ids_(ids)
+        , properties_(properties) {}
+
+    const_iterator begin() const noexcept {
+        return {ids_.data(), properties_};
+    }
+    const_iterator end() const noexcept {
+        return {ids_.data() + ids_.size(), properties_};
+    }
+    size_t size() const noexcept {
+        return ids_.size();
+    }
+    bool empty() const noexcept {
+        return ids_.empty();
+    }
+    SectionView operator[](size_t i) const noexcept {
+        return {ids_[i], properties_};
+    }
+
+    /** Return the IDs of the sections */
+    range<const uint32_t> ids() const noexcept {
+        return ids_;
+    }
+
+  private:
+    range<const uint32_t> ids_;
+    const Property::Properties* properties_;
+};
+
+inline SectionViewRange SectionView::children() const noexcept {
+    return {childrenIds(), properties_};
+}
+
+}  // namespace morphio
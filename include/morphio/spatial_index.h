@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <cstdint>  // uint32_t
+#include <memory>   // std::shared_ptr
+#include <vector>
+
+#include <morphio/properties.h>
+#include <morphio/types.h>
+#include <morphio/vector_types.h>
+
+namespace morphio {
+
+/** A segment of a section: the part between its points `segment` and `segment + 1` */
+struct SegmentId {
+    uint32_t section;
+    uint32_t segment;
+
+    bool operator==(const SegmentId& other) const noexcept {
+        return section == other.section && segment == other.segment;
+    }
+    bool operator!=(const SegmentId& other) const noexcept {
+        return !(*this == other);
+    }
+    bool operator<(const SegmentId& other) const noexcept {
+        return section < other.section || (section == other.section && segment < other.segment);
+    }
+};
+
+/** The segment nearest to a point, and the distance from the point to its surface */
+struct NearestSegment {
+    SegmentId segment;
+    floatType distance;
+};
+
+namespace detail {
+/**
+ * A node of a bounding volume hierarchy: a leaf if `count` > 0, holding the items
+ * `first` to `first + count` in leaf order, otherwise an inner node with children `left`
+ * and `right`
+ */
+struct BVHNode {
+    Point min;
+    Point max;
+    uint32_t left;
+    uint32_t right;
+    uint32_t first;
+    uint32_t count;
+};
+}  // namespace detail
+
+/**
+ * A bounding volume hierarchy over the segments of a morphology.
+ *
+ * Every segment is modelled as a capsule: the points within a radius of the line segment
+ * joining its two points, the radius being the larger of the two point radii. Queries
+ * return the segments whose capsule matches, sorted by section and segment.
+ *
+ * The index only stores the hierarchy and the segment IDs: the coordinates are read from
+ * the morphology data, which the index keeps alive.
+ *
+ * Note: This API is 'experimental', meaning it might change in the future.
+ */
+class SegmentIndex
+{
+  public:
+    /**
+     * Build the index of the segments of `morphology` using `n_threads` threads,
+     * 0 meaning one per hardware thread
+     */
+    explicit SegmentIndex(const Morphology& morphology, size_t n_threads = 1);
+
+    /** Return the number of indexed segments */
+    size_t size() const noexcept {
+        return _items.size();
+    }
+
+    /** Return the lower and upper corners of the box bounding all segments */
+    std::array<Point, 2> bounds() const;
+
+    /** Return the segments whose capsule intersects the sphere of `center` and `radius` */
+    std::vector<SegmentId> sphereQuery(const Point& center, floatType radius) const;
+
+    /**
+     * Run one sphere query per element of `centers` and `radii`, using `n_threads`
+     * threads
+     *
+     * @throw MorphioError if `centers` and `radii` have different sizes
+     */
+    std::vector<std::vector<SegmentId>> sphereQuery(const Points& centers,
+                                                    const std::vector<floatType>& radii,
+                                                    size_t n_threads = 0) const;
+
+    /** Return the segments whose capsule bounding box intersects the box [`min`, `max`] */
+    std::vector<SegmentId> boxQuery(const Point& min, const Point& max) const;
+
+    /**
+     * Run one box query per element of `mins` and `maxs`, using `n_threads` threads
+     *
+     * @throw MorphioError if `mins` and `maxs` have different sizes
+     */
+    std::vector<std::vector<SegmentId>> boxQuery(const Points& mins,
+                                                 const Points& maxs,
+                                                 size_t n_threads = 0) const;
+
+    /**
+     * Return the segments whose capsule intersects the capsule of radius `radius` around
+     * the line segment [`start`, `end`]
+     */
+    std::vector<SegmentId> capsuleQuery(const Point& start,
+                                        const Point& end,
+                                        floatType radius) const;
+
+    /**
+     * Return the segment whose capsule surface is nearest to `point`, the distance being 0
+     * if the point is inside a capsule
+     *
+     * @throw MorphioError if the index is empty
+     */
+    NearestSegment nearest(const Point& point) const;
+
+    /** Run one nearest query per element of `points`, using `n_threads` threads */
+    std::vector<NearestSegment> nearest(const Points& points, size_t n_threads = 0) const;
+
+  private:
+    /** A segment, with the index in the points array of its first point */
+    struct Item {
+        uint32_t point;
+        SegmentId id;
+    };
+
+    /** Return the start point, end point and radius of the capsule of `item` */
+    void capsule(const Item& item, Point& start, Point& end, floatType& radius) const noexcept;
+
+    std::shared_ptr<Property::Properties> _properties;
+    /** The segments, in the leaf order of `_nodes` */
+    std::vector<Item> _items;
+    std::vector<detail::BVHNode> _nodes;
+
+    friend class CircuitIndex;
+};
+
+}  // namespace morphio
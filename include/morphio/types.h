@@ -14,7 +14,10 @@ class EndoplasmicReticulum;
 class MitoSection;
 class Mitochondria;
 class Morphology;
+struct Morphometrics;
 class Section;
+class SectionView;
+class SectionViewRange;
 
 template <class T>
 class SectionBase;
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <algorithm>  // std::min, std::max, std::nth_element
+#include <cstdint>    // uint32_t
+#include <limits>
+#include <vector>
+
+#include <morphio/spatial_index.h>
+#include <morphio/vector_types.h>
+
+#include "thread_pool.h"
+
+namespace morphio {
+namespace detail {
+
+inline floatType squaredDistanceToBox(const Point& point, const Point& min, const Point& max) {
+    floatType result = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        const floatType d = std::max(std::max(min[i] - point[i], point[i] - max[i]), floatType{0});
+        result += d * d;
+    }
+    return result;
+}
+
+inline bool boxesIntersect(const Point& min0,
+                           const Point& max0,
+                           const Point& min1,
+                           const Point& max1) {
+    for (size_t i = 0; i < 3; ++i) {
+        if (max0[i] < min1[i] || max1[i] < min0[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Build a bounding volume hierarchy over the boxes [`mins[i]`, `maxs[i]`].
+ *
+ * The boxes are split at the median of their centers along the widest axis, until at most
+ * `leafSize` remain. `order` receives the box indices in leaf order: a leaf holds the boxes
+ * `order[first:first + count]`. With several threads, the subtrees below the top levels
+ * are built concurrently, each into its own node array, and spliced together afterwards.
+ */
+class HierarchyBuilder
+{
+  public:
+    HierarchyBuilder(const std::vector<Point>& mins,
+                     const std::vector<Point>& maxs,
+                     uint32_t leafSize)
+        : _mins(mins)
+        , _maxs(maxs)
+        , _centers(mins.size())
+        , _leafSize(leafSize) {
+        for (size_t i = 0; i < mins.size(); ++i) {
+            for (size_t axis = 0; axis < 3; ++axis) {
+                _centers[i][axis] = (mins[i][axis] + maxs[i][axis]) / 2;
+            }
+        }
+    }
+
+    void build(size_t n_threads, std::vector<BVHNode>& nodes, std::vector<uint32_t>& order) {
+        const auto n = static_cast<uint32_t>(_mins.size());
+        nodes.clear();
+        _order.resize(n);
+        for (uint32_t i = 0; i < n; ++i) {
+            _order[i] = i;
+        }
+
+        if (n_threads == 0) {
+            n_threads = defaultThreadCount();
+        }
+
+        if (n > 0) {
+            nodes.reserve(2 * n / _leafSize + 1);
+            if (n_threads <= 1) {
+                buildNode(0, n, nodes, nullptr, 0);
+            } else {
+                buildParallel(n_threads, nodes);
+            }
+        }
+        order = std::move(_order);
+    }
+
+  private:
+    struct Task {
+        uint32_t node;
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    void buildParallel(size_t n_threads, std::vector<BVHNode>& nodes) {
+        // Stop the top of the tree at a depth giving a few subtrees per thread
+        size_t depth = 2;
+        while ((size_t{1} << depth) < 4 * n_threads) {
+            ++depth;
+        }
+        std::vector<Task> tasks;
+        buildNode(0, static_cast<uint32_t>(_order.size()), nodes, &tasks, depth);
+
+        std::vector<std::vector<BVHNode>> subtrees(tasks.size());
+        parallel_for(tasks.size(), n_threads, [&](size_t i) {
+            buildNode(tasks[i].begin, tasks[i].end, subtrees[i], nullptr, 0);
+        });
+
+        // The root of a subtree replaces its placeholder, the other nodes are appended
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            const auto base = static_cast<uint32_t>(nodes.size());
+            const uint32_t placeholder = tasks[i].node;
+            const auto remap = [base, placeholder](uint32_t local) {
+                return local == 0 ? placeholder : base + local - 1;
+            };
+            for (size_t j = 0; j < subtrees[i].size(); ++j) {
+                BVHNode node = subtrees[i][j];
+                if (node.count == 0) {
+                    node.left = remap(node.left);
+                    node.right = remap(node.right);
+                }
+                if (j == 0) {
+                    nodes[placeholder] = node;
+                } else {
+                    nodes.push_back(node);
+                }
+            }
+        }
+    }
+
+    uint32_t buildNode(uint32_t begin,
+                       uint32_t end,
+                       std::vector<BVHNode>& nodes,
+                       std::vector<Task>* tasks,
+                       size_t depth) {
+        constexpr floatType maxFloat = std::numeric_limits<floatType>::max();
+        const auto index = static_cast<uint32_t>(nodes.size());
+        BVHNode node{{maxFloat, maxFloat, maxFloat},
+                     {-maxFloat, -maxFloat, -maxFloat},
+                     0,
+                     0,
+                     begin,
+                     end - begin};
+        Point centerMin = node.min;
+        Point centerMax = node.max;
+        for (uint32_t i = begin; i < end; ++i) {
+            const uint32_t item = _order[i];
+            for (size_t axis = 0; axis < 3; ++axis) {
+                node.min[axis] = std::min(node.min[axis], _mins[item][axis]);
+                node.max[axis] = std::max(node.max[axis], _maxs[item][axis]);
+                centerMin[axis] = std::min(centerMin[axis], _centers[item][axis]);
+                centerMax[axis] = std::max(centerMax[axis], _centers[item][axis]);
+            }
+        }
+        nodes.push_back(node);
+
+        if (end - begin <= _leafSize) {
+            return index;
+        }
+        if (tasks != nullptr && depth == 0) {
+            tasks->push_back({index, begin, end});
+            return index;
+        }
+
+        size_t axis = 0;
+        for (size_t i = 1; i < 3; ++i) {
+            if (centerMax[i] - centerMin[i] > centerMax[axis] - centerMin[axis]) {
+                axis = i;
+            }
+        }
+        const uint32_t middle = begin + (end - begin) / 2;
+        std::nth_element(_order.begin() + begin,
+                         _order.begin() + middle,
+                         _order.begin() + end,
+                         [this, axis](uint32_t left, uint32_t right) {
+                             return _centers[left][axis] < _centers[right][axis];
+                         });
+
+        const uint32_t left = buildNode(begin, middle, nodes, tasks, depth - 1);
+        const uint32_t right = buildNode(middle, end, nodes, tasks, depth - 1);
+        nodes[index].left = left;
+        nodes[index].right = right;
+        nodes[index].count = 0;
+        return index;
+    }
+
+    const std::vector<Point>& _mins;
+    const std::vector<Point>& _maxs;
+    std::vector<Point> _centers;
+    std::vector<uint32_t> _order;
+    uint32_t _leafSize;
+};
+
+/**
+ * Call `visitor(i)` for the positions `i` in leaf order of the boxes held by the leaves
+ * reached through nodes passing `test(node)`
+ */
+template <typename NodeTest, typename Visitor>
+void visitHierarchy(const std::vector<BVHNode>& nodes,
+                    const NodeTest& test,
+                    const Visitor& visitor) {
+    if (nodes.empty()) {
+        return;
+    }
+    std::vector<uint32_t> stack{0};
+    while (!stack.empty()) {
+        const BVHNode& node = nodes[stack.back()];
+        stack.pop_back();
+        if (!test(node)) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                visitor(i);
+            }
+        } else {
+            stack.push_back(node.right);
+            stack.push_back(node.left);
+        }
+    }
+}
+
+}  // namespace detail
+}  // namespace morphio
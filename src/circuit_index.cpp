@@ -0,0 +1,220 @@
+#include <algorithm>  // std::sort
+#include <cmath>      // std::fabs
+#include <limits>
+#include <string>   // std::to_string
+#include <utility>  // std::move
+
+#include <morphio/circuit_index.h>
+#include <morphio/exceptions.h>
+
+#include "bounding_volume_hierarchy.h"
+#include "thread_pool.h"
+
+namespace morphio {
+namespace {
+
+/** Leaves of the top-level hierarchy hold at most this many cells */
+constexpr uint32_t kCellLeafSize = 4;
+
+/** Tolerance on the orthonormality of the rotation part of the transforms */
+constexpr floatType kRigidTolerance = floatType{1e-4};
+
+Point apply(const Transform& transform, const Point& point) {
+    Point result;
+    for (size_t row = 0; row < 3; ++row) {
+        result[row] = transform[row][3];
+        for (size_t column = 0; column < 3; ++column) {
+            result[row] += transform[row][column] * point[column];
+        }
+    }
+    return result;
+}
+
+/** Apply the inverse of the rigid `transform`: the transposed rotation of the translated point */
+Point applyInverse(const Transform& transform, const Point& point) {
+    Point result{0, 0, 0};
+    for (size_t row = 0; row < 3; ++row) {
+        const floatType translated = point[row] - transform[row][3];
+        for (size_t column = 0; column < 3; ++column) {
+            result[column] += transform[row][column] * translated;
+        }
+    }
+    return result;
+}
+
+/** Return the box bounding the image by `f` of the corners of the box `bounds` */
+template <typename F>
+std::array<Point, 2> transformBox(const std::array<Point, 2>& bounds, const F& f) {
+    constexpr floatType maxFloat = std::numeric_limits<floatType>::max();
+    std::array<Point, 2> result{Point{maxFloat, maxFloat, maxFloat},
+                                Point{-maxFloat, -maxFloat, -maxFloat}};
+    for (size_t corner = 0; corner < 8; ++corner) {
+        const Point image = f(Point{bounds[corner & 1][0],
+                                    bounds[(corner >> 1) & 1][1],
+                                    bounds[(corner >> 2) & 1][2]});
+        for (size_t axis = 0; axis < 3; ++axis) {
+            result[0][axis] = std::min(result[0][axis], image[axis]);
+            result[1][axis] = std::max(result[1][axis], image[axis]);
+        }
+    }
+    return result;
+}
+
+std::array<Point, 2> expand(std::array<Point, 2> bounds, floatType distance) {
+    for (size_t axis = 0; axis < 3; ++axis) {
+        bounds[0][axis] -= distance;
+        bounds[1][axis] += distance;
+    }
+    return bounds;
+}
+
+bool isRigid(const Transform& transform) {
+    for (size_t column = 0; column < 4; ++column) {
+        const floatType expected = column == 3 ? 1 : 0;
+        if (std::fabs(transform[3][column] - expected) > kRigidTolerance) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            floatType dot = 0;
+            for (size_t k = 0; k < 3; ++k) {
+                dot += transform[i][k] * transform[j][k];
+            }
+            if (std::fabs(dot - (i == j ? 1 : 0)) > kRigidTolerance) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+CircuitIndex::CircuitIndex(std::vector<Morphology> morphologies,
+                           std::vector<Transform> transforms,
+                           size_t n_threads)
+    : _morphologies(std::move(morphologies))
+    , _transforms(std::move(transforms)) {
+    if (_morphologies.size() != _transforms.size()) {
+        throw MorphioError("CircuitIndex: got " + std::to_string(_morphologies.size()) +
+                           " morphologies but " + std::to_string(_transforms.size()) +
+                           " transforms");
+    }
+    for (size_t i = 0; i < _transforms.size(); ++i) {
+        if (!isRigid(_transforms[i])) {
+            throw MorphioError("CircuitIndex: the transform of cell " + std::to_string(i) +
+                               " is not made of a rotation and a translation");
+        }
+    }
+
+    const size_t n = _morphologies.size();
+    _cellIndices.resize(n);
+    _cellBounds.resize(n);
+    detail::parallel_for(n, n_threads, [&](size_t i) {
+        _cellIndices[i].reset(new SegmentIndex(_morphologies[i], 1));
+        if (_cellIndices[i]->size() == 0) {
+            // An inverted box, which intersects nothing
+            constexpr floatType maxFloat = std::numeric_limits<floatType>::max();
+            _cellBounds[i] = {Point{maxFloat, maxFloat, maxFloat},
+                              Point{-maxFloat, -maxFloat, -maxFloat}};
+        } else {
+            _cellBounds[i] = transformBox(_cellIndices[i]->bounds(), [&](const Point& point) {
+                return apply(_transforms[i], point);
+            });
+        }
+    });
+
+    std::vector<Point> mins(n);
+    std::vector<Point> maxs(n);
+    for (size_t i = 0; i < n; ++i) {
+        mins[i] = _cellBounds[i][0];
+        maxs[i] = _cellBounds[i][1];
+    }
+    detail::HierarchyBuilder(mins, maxs, kCellLeafSize).build(n_threads, _nodes, _cellOrder);
+}
+
+CircuitIndex::~CircuitIndex() = default;
+
+std::vector<std::array<uint32_t, 2>> CircuitIndex::cellPairs(floatType distance) const {
+    std::vector<std::array<uint32_t, 2>> result;
+    for (uint32_t cell = 0; cell < size(); ++cell) {
+        const auto bounds = expand(_cellBounds[cell], distance);
+        detail::visitHierarchy(
+            _nodes,
+            [&](const detail::BVHNode& node) {
+                return detail::boxesIntersect(node.min, node.max, bounds[0], bounds[1]);
+            },
+            [&](uint32_t i) {
+                const uint32_t other = _cellOrder[i];
+                if (other > cell && detail::boxesIntersect(_cellBounds[other][0],
+                                                           _cellBounds[other][1],
+                                                           bounds[0],
+                                                           bounds[1])) {
+                    result.push_back({cell, other});
+                }
+            });
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<SegmentPair> CircuitIndex::segmentPairs(floatType distance, size_t n_threads) const {
+    const auto pairs = cellPairs(distance);
+    std::vector<std::vector<SegmentPair>> results(pairs.size());
+    detail::parallel_for(pairs.size(), n_threads, [&](size_t i) {
+        results[i] = segmentPairs(pairs[i][0], pairs[i][1], distance);
+    });
+
+    size_t total = 0;
+    for (const auto& pairResults : results) {
+        total += pairResults.size();
+    }
+    std::vector<SegmentPair> result;
+    result.reserve(total);
+    for (const auto& pairResults : results) {
+        result.insert(result.end(), pairResults.begin(), pairResults.end());
+    }
+    return result;
+}
+
+std::vector<SegmentPair> CircuitIndex::segmentPairs(uint32_t cell0,
+                                                    uint32_t cell1,
+                                                    floatType distance) const {
+    const Transform& transform0 = _transforms[cell0];
+    const Transform& transform1 = _transforms[cell1];
+    const SegmentIndex& index0 = *_cellIndices[cell0];
+    const SegmentIndex& index1 = *_cellIndices[cell1];
+
+    // Only the segments of cell0 near the box of cell1 can be part of a pair
+    const auto bounds = transformBox(expand(_cellBounds[cell1], distance),
+                                     [&](const Point& point) {
+                                         return applyInverse(transform0, point);
+                                     });
+
+    std::vector<SegmentPair> result;
+    detail::visitHierarchy(
+        index0._nodes,
+        [&](const detail::BVHNode& node) {
+            return detail::boxesIntersect(node.min, node.max, bounds[0], bounds[1]);
+        },
+        [&](uint32_t i) {
+            Point start;
+            Point end;
+            floatType radius;
+            index0.capsule(index0._items[i], start, end, radius);
+            start = applyInverse(transform1, apply(transform0, start));
+            end = applyInverse(transform1, apply(transform0, end));
+            for (const auto& segment : index1.capsuleQuery(start, end, radius + distance)) {
+                result.push_back({cell0, index0._items[i].id, cell1, segment});
+            }
+        });
+
+    std::sort(result.begin(), result.end(), [](const SegmentPair& left, const SegmentPair& right) {
+        return left.segment0 < right.segment0 ||
+               (left.segment0 == right.segment0 && left.segment1 < right.segment1);
+    });
+    return result;
+}
+
+}  // namespace morphio
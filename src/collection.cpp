@@ -1,6 +1,12 @@
+#include <deque>
+#include <future>
+#include <mutex>
+
 #include <morphio/collection.h>
+#include <morphio/morphology_pack.h>
 
 #include "shared_utils.hpp"
+#include "thread_pool.h"
 #include <highfive/H5File.hpp>
 
 #include "readers/morphologyHDF5.h"
@@ -84,6 +90,51 @@ class CollectionImpl
                                                               unsigned int options) const = 0;
 
     virtual std::vector<size_t> argsort(const std::vector<std::string>& morphology_names) const = 0;
+
+    /**
+     * Whether loads are serialized, e.g. by the HDF5 lock.
+     *
+     * Concurrent asynchronous requests are then served in `argsort` order by a
+     * single worker, instead of contending for the lock in arbitrary order.
+     */
+    virtual bool serializes_loads() const {
+        return false;
+    }
+
+    virtual std::vector<Morphology> load_many(const std::vector<std::string>& morphology_names,
+                                              unsigned int options,
+                                              size_t n_threads) const {
+        const size_t n_morphologies = morphology_names.size();
+        std::vector<std::unique_ptr<Morphology>> loaded(n_morphologies);
+
+        if (serializes_loads()) {
+            // Concurrent loads would only contend for the lock, read in file order instead
+            for (auto i : argsort(morphology_names)) {
+                loaded[i] = std::make_unique<Morphology>(load(morphology_names[i], options));
+            }
+        } else {
+            detail::parallel_for(n_morphologies, n_threads, [&](size_t i) {
+                loaded[i] = std::make_unique<Morphology>(load(morphology_names[i], options));
+            });
+        }
+
+        std::vector<Morphology> morphologies;
+        morphologies.reserve(n_morphologies);
+        for (auto& morphology : loaded) {
+            morphologies.push_back(std::move(*morphology));
+        }
+        return morphologies;
+    }
+
+    virtual MorphologyBatch load_batch(const std::vector<std::string>& morphology_names,
+                                       unsigned int options,
+                                       size_t n_threads) const {
+        MorphologyBatch batch;
+        for (const auto& morphology : load_many(morphology_names, options, n_threads)) {
+            batch.append(morphology);
+        }
+        return batch;
+    }
 };
 
 namespace detail {
@@ -182,6 +233,8 @@ class HDF5ContainerCollection: public morphio::detail::CollectionImpl<HDF5Contai
     HDF5ContainerCollection& operator=(HDF5ContainerCollection&&) = delete;
 
     std::vector<size_t> argsort(const std::vector<std::string>& morphology_names) const override {
+        std::lock_guard<std::recursive_mutex> lock(morphio::readers::h5::global_hdf5_mutex());
+
         auto n_morphologies = morphology_names.size();
         std::vector<hsize_t> offsets(n_morphologies);
         std::vector<size_t> loop_indices(n_morphologies);
@@ -206,6 +259,10 @@ class HDF5ContainerCollection: public morphio::detail::CollectionImpl<HDF5Contai
         return loop_indices;
     }
 
+    bool serializes_loads() const override {
+        return true;
+    }
+
   protected:
     friend morphio::detail::CollectionImpl<HDF5ContainerCollection>;
 
@@ -225,6 +282,48 @@ class HDF5ContainerCollection: public morphio::detail::CollectionImpl<HDF5Contai
     HighFive::File _file;
 };
 
+class PackCollection: public morphio::detail::CollectionImpl<PackCollection>
+{
+  public:
+    PackCollection(const std::string& collection_path)
+        : _pack(collection_path) {}
+
+    std::vector<size_t> argsort(const std::vector<std::string>& morphology_names) const override {
+        auto n_morphologies = morphology_names.size();
+        std::vector<size_t> offsets(n_morphologies);
+        std::vector<size_t> loop_indices(n_morphologies);
+
+        for (size_t i = 0; i < n_morphologies; ++i) {
+            loop_indices[i] = i;
+            offsets[i] = _pack.offset(_pack.index(morphology_names[i]));
+        }
+
+        std::sort(loop_indices.begin(), loop_indices.end(), [&offsets](size_t i, size_t j) {
+            return offsets[i] < offsets[j];
+        });
+
+        return loop_indices;
+    }
+
+    MorphologyBatch load_batch(const std::vector<std::string>& morphology_names,
+                               unsigned int options,
+                               size_t /* n_threads */) const override {
+        // Copying from the mapped file is bound by memory bandwidth, not worth threads
+        return _pack.loadBatch(morphology_names, options);
+    }
+
+  protected:
+    friend morphio::detail::CollectionImpl<PackCollection>;
+
+    template <class M>
+    M load_impl(const std::string& morph_name, unsigned int options) const {
+        return M(_pack.load(morph_name, options));
+    }
+
+  private:
+    MorphologyPack _pack;
+};
+
 namespace detail {
 static std::shared_ptr<morphio::CollectionImpl> open_collection(
     std::string collection_path, std::vector<std::string> extensions) {
@@ -235,6 +334,10 @@ static std::shared_ptr<morphio::CollectionImpl> open_collection(
                                                      std::move(extensions));
     }
 
+    if (morphio::is_regular_file(collection_path) && MorphologyPack::isPack(collection_path)) {
+        return std::make_shared<PackCollection>(collection_path);
+    }
+
     if (morphio::is_regular_file(collection_path)) {
         // Prepare to load from containers.
         return std::make_shared<HDF5ContainerCollection>(std::move(collection_path));
@@ -245,11 +348,158 @@ static std::shared_ptr<morphio::CollectionImpl> open_collection(
 
 }  // namespace detail
 
+/**
+ * The executor behind `Collection::load_async`.
+ *
+ * Requests are queued and every request submits one drain task to the thread pool.
+ * A drain task serves one request, or, for collections that serialize their loads,
+ * all the pending requests sorted by `argsort`, so that concurrent requests for the
+ * same container result in sequential reads.
+ */
+class AsyncLoader
+{
+  public:
+    explicit AsyncLoader(std::shared_ptr<CollectionImpl> collection)
+        : _collection(std::move(collection))
+        , _n_threads(detail::defaultThreadCount()) {}
+
+    ~AsyncLoader() {
+        // Joining the workers serves the pending requests
+        set_threads(_n_threads);
+    }
+
+    AsyncLoader(const AsyncLoader&) = delete;
+    AsyncLoader& operator=(const AsyncLoader&) = delete;
+
+    template <class M>
+    std::future<M> load(const std::string& morph_name, unsigned int options) {
+        auto promise = std::make_shared<std::promise<M>>();
+        auto future = promise->get_future();
+
+        Request request;
+        request.morph_name = morph_name;
+        request.run = [this, promise, morph_name, options]() {
+            try {
+                promise->set_value(load_impl<M>(morph_name, options));
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        };
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending.push_back(std::move(request));
+        if (_pool == nullptr) {
+            _pool.reset(new detail::ThreadPool(_n_threads));
+        }
+        if (!_collection->serializes_loads()) {
+            _pool->submit([this]() { run_next(); });
+        } else if (!_draining) {
+            // A single drain is in flight, it also serves the requests queued while it runs
+            _draining = true;
+            _pool->submit([this]() { drain(); });
+        }
+
+        return future;
+    }
+
+    void set_threads(size_t n_threads) {
+        std::unique_ptr<detail::ThreadPool> previous_pool;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _n_threads = std::max<size_t>(1, n_threads);
+            previous_pool = std::move(_pool);
+        }
+        // The requests already submitted are served by the previous pool before it is joined
+        previous_pool.reset();
+    }
+
+  private:
+    struct Request {
+        std::string morph_name;
+        std::function<void()> run;
+    };
+
+    template <class M>
+    typename enable_if_immutable<M, M>::type load_impl(const std::string& morph_name,
+                                                       unsigned int options) const {
+        return _collection->load(morph_name, options);
+    }
+
+    template <class M>
+    typename enable_if_mutable<M, M>::type load_impl(const std::string& morph_name,
+                                                     unsigned int options) const {
+        return _collection->load_mut(morph_name, options);
+    }
+
+    void run_next() {
+        Request request;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            request = std::move(_pending.front());
+            _pending.pop_front();
+        }
+        request.run();
+    }
+
+    /** Serve the pending requests in batches, sorted by the collection, until none is left */
+    void drain() {
+        while (true) {
+            std::vector<Request> batch;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_pending.empty()) {
+                    _draining = false;
+                    return;
+                }
+                batch.assign(std::make_move_iterator(_pending.begin()),
+                             std::make_move_iterator(_pending.end()));
+                _pending.clear();
+            }
+            run_sorted(batch);
+        }
+    }
+
+    void run_sorted(std::vector<Request>& batch) const {
+        if (batch.size() == 1) {
+            batch.front().run();
+            return;
+        }
+
+        std::vector<size_t> loop_indices;
+        try {
+            std::vector<std::string> morph_names;
+            morph_names.reserve(batch.size());
+            for (const auto& request : batch) {
+                morph_names.push_back(request.morph_name);
+            }
+            loop_indices = _collection->argsort(morph_names);
+        } catch (...) {
+            // Unknown names make argsort fail, each request then reports its own error
+            loop_indices.resize(batch.size());
+            for (size_t i = 0; i < batch.size(); ++i) {
+                loop_indices[i] = i;
+            }
+        }
+
+        for (auto i : loop_indices) {
+            batch[i].run();
+        }
+    }
+
+    std::shared_ptr<CollectionImpl> _collection;
+    std::mutex _mutex;
+    std::deque<Request> _pending;
+    bool _draining = false;
+    size_t _n_threads;
+    std::unique_ptr<detail::ThreadPool> _pool;
+};
+
 Collection::Collection(std::shared_ptr<CollectionImpl> collection)
     : _collection(std::move(collection)) {
     if (_collection == nullptr) {
         throw std::invalid_argument("Can't construct a collection from a nullptr.");
     }
+    _async_loader = std::make_shared<AsyncLoader>(_collection);
 }
 
 Collection::Collection(std::string collection_path, std::vector<std::string> extensions)
@@ -304,8 +554,54 @@ template LoadUnordered<Morphology> Collection::load_unordered<Morphology>(
     std::vector<std::string> morphology_names, unsigned int options) const;
 
 
+std::vector<Morphology> Collection::load_many(const std::vector<std::string>& morphology_names,
+                                              unsigned int options,
+                                              size_t n_threads) const {
+    if (_collection != nullptr) {
+        return _collection->load_many(morphology_names, options, n_threads);
+    }
+
+    throw std::runtime_error("The collection has been closed.");
+}
+
+MorphologyBatch Collection::load_batch(const std::vector<std::string>& morphology_names,
+                                      unsigned int options,
+                                      size_t n_threads) const {
+    if (_collection != nullptr) {
+        return _collection->load_batch(morphology_names, options, n_threads);
+    }
+
+    throw std::runtime_error("The collection has been closed.");
+}
+
+template <class M>
+std::future<M> Collection::load_async(const std::string& morph_name,
+                                      unsigned int options) const {
+    if (_collection != nullptr) {
+        return _async_loader->load<M>(morph_name, options);
+    }
+
+    throw std::runtime_error("The collection has been closed.");
+}
+
+template std::future<Morphology> Collection::load_async<Morphology>(
+    const std::string& morph_name, unsigned int options) const;
+
+template std::future<mut::Morphology> Collection::load_async<mut::Morphology>(
+    const std::string& morph_name, unsigned int options) const;
+
+void Collection::set_async_threads(size_t n_threads) {
+    if (_collection != nullptr) {
+        _async_loader->set_threads(n_threads);
+        return;
+    }
+
+    throw std::runtime_error("The collection has been closed.");
+}
+
 void Collection::close() {
     _collection = nullptr;
+    _async_loader = nullptr;
 }
 
 
@@ -1,14 +1,28 @@
 //#include <cmath>
+#include <atomic>
 #include <iostream>  // std::cerr
-#include <sstream>   // std::ostringstream
+#include <mutex>
+#include <sstream>  // std::ostringstream
 #include <string>
 #include <vector>
 
 #include <morphio/errorMessages.h>
 
+#include "readers/scopedIgnoredWarning.h"
+
 namespace morphio {
-static int MORPHIO_MAX_N_WARNINGS = 100;
-static bool MORPHIO_RAISE_WARNINGS = false;
+static std::atomic<int> MORPHIO_MAX_N_WARNINGS{100};
+static std::atomic<bool> MORPHIO_RAISE_WARNINGS{false};
+
+// Morphologies can be loaded concurrently (e.g. Collection::load_async), this
+// protects the set of ignored warnings and the count of printed warnings
+static std::mutex& warningsMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Warnings ignored by the calling thread only, see readers::ScopedIgnoredWarning
+static thread_local std::set<Warning> threadIgnoredWarnings;
 
 /**
    Controls the maximum number of warning to be printed on screen
@@ -27,6 +41,7 @@ void set_raise_warnings(bool is_raise) {
 }
 
 void set_ignored_warning(Warning warning, bool ignore) {
+    std::lock_guard<std::mutex> lock(warningsMutex());
     if (ignore) {
         readers::_ignoredWarnings.insert(warning);
     } else {
@@ -51,6 +66,7 @@ void printError(Warning warning, const std::string& msg) {
         throw MorphioError(msg);
     }
 
+    std::lock_guard<std::mutex> lock(warningsMutex());
     if (MORPHIO_MAX_N_WARNINGS < 0 || error <= MORPHIO_MAX_N_WARNINGS) {
         std::cerr << msg << '\n';
         if (error == MORPHIO_MAX_N_WARNINGS) {
@@ -67,9 +83,23 @@ void printError(Warning warning, const std::string& msg) {
 
 namespace readers {
 bool ErrorMessages::isIgnored(Warning warning) {
+    if (threadIgnoredWarnings.find(warning) != threadIgnoredWarnings.end()) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(warningsMutex());
     return _ignoredWarnings.find(warning) != _ignoredWarnings.end();
 }
 
+ScopedIgnoredWarning::ScopedIgnoredWarning(Warning warning)
+    : _warning(warning)
+    , _inserted(threadIgnoredWarnings.insert(warning).second) {}
+
+ScopedIgnoredWarning::~ScopedIgnoredWarning() {
+    if (_inserted) {
+        threadIgnoredWarnings.erase(_warning);
+    }
+}
+
 std::string ErrorMessages::errorMsg(long unsigned int lineNumber,
                                     ErrorLevel errorLevel,
                                     std::string msg) const {
@@ -3,7 +3,7 @@
 namespace morphio {
 
 mito_depth_iterator MitoSection::depth_begin() const {
-    return mito_depth_iterator(*this);
+    return mito_depth_iterator(properties_, subtreeIds());
 }
 
 mito_depth_iterator MitoSection::depth_end() const {
@@ -11,7 +11,7 @@ mito_depth_iterator MitoSection::depth_end() const {
 }
 
 mito_breadth_iterator MitoSection::breadth_begin() const {
-    return mito_breadth_iterator(*this);
+    return mito_breadth_iterator(properties_, breadthFirstIds());
 }
 
 mito_breadth_iterator MitoSection::breadth_end() const {
@@ -15,16 +15,12 @@ std::vector<MitoSection> Mitochondria::sections() const {
 }
 
 std::vector<MitoSection> Mitochondria::rootSections() const {
-    std::vector<MitoSection> result;
-    const auto& mitoChildren = properties_->children<morphio::Property::MitoSection>();
-    const auto& it = mitoChildren.find(-1);
-    if (it != mitoChildren.end()) {
-        const auto& children = it->second;
+    const auto children = properties_->children<morphio::Property::MitoSection>().roots();
 
-        result.reserve(children.size());
-        for (auto id : children) {
-            result.push_back(section(id));
-        }
+    std::vector<MitoSection> result;
+    result.reserve(children.size());
+    for (auto id : children) {
+        result.push_back(section(id));
     }
     return result;
 }
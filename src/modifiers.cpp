@@ -0,0 +1,232 @@
+#include <algorithm>  // std::stable_sort
+#include <cmath>
+#include <cstdint>  // int32_t, uint32_t
+#include <vector>
+
+#include <morphio/exceptions.h>
+
+#include "modifiers.h"
+
+namespace morphio {
+namespace modifiers {
+namespace {
+
+/** Return the new position of every section: depth first, from the roots sorted by type */
+std::vector<uint32_t> nrnOrder(const Property::Properties& properties) {
+    const auto& sections = properties._sectionLevel._sections;
+    const auto& types = properties._sectionLevel._sectionTypes;
+
+    std::vector<uint32_t> roots;
+    std::vector<std::vector<uint32_t>> children(sections.size());
+    for (uint32_t i = 0; i < sections.size(); ++i) {
+        if (sections[i][1] < 0) {
+            roots.push_back(i);
+        } else {
+            children[static_cast<size_t>(sections[i][1])].push_back(i);
+        }
+    }
+    std::stable_sort(roots.begin(), roots.end(), [&types](uint32_t left, uint32_t right) {
+        return types[left] < types[right];
+    });
+
+    std::vector<uint32_t> order;
+    order.reserve(sections.size());
+    std::vector<uint32_t> stack;
+    for (uint32_t root : roots) {
+        stack.push_back(root);
+        while (!stack.empty()) {
+            const uint32_t id = stack.back();
+            stack.pop_back();
+            order.push_back(id);
+            stack.insert(stack.end(), children[id].rbegin(), children[id].rend());
+        }
+    }
+    return order;
+}
+
+/**
+ * Keep the points of the sections selected by NO_DUPLICATES and TWO_POINTS_SECTIONS, the
+ * sections being laid out in `order`, old IDs at their new position
+ */
+void compactSections(Property::Properties& properties,
+                     unsigned int options,
+                     const std::vector<uint32_t>& order) {
+    auto& sections = properties._sectionLevel._sections;
+    auto& types = properties._sectionLevel._sectionTypes;
+    auto& pointLevel = properties._pointLevel;
+    const size_t sectionCount = sections.size();
+    const size_t pointCount = pointLevel._points.size();
+    const bool hasPerimeters = !pointLevel._perimeters.empty();
+
+    // The points of section `id`, in [begin, end), of which only the ends are kept if
+    // `endsOnly`
+    struct Kept {
+        size_t begin;
+        size_t end;
+        bool endsOnly;
+    };
+    const auto kept = [&](uint32_t id) {
+        Kept result{static_cast<size_t>(sections[id][0]),
+                    id + 1 == sectionCount ? pointCount
+                                           : static_cast<size_t>(sections[id + 1][0]),
+                    false};
+        if ((options & NO_DUPLICATES) && result.end > result.begin && sections[id][1] >= 0) {
+            ++result.begin;
+        }
+        result.endsOnly = (options & TWO_POINTS_SECTIONS) && result.end - result.begin > 2;
+        return result;
+    };
+
+    bool inPlace = true;
+    for (uint32_t i = 0; i < sectionCount; ++i) {
+        inPlace = inPlace && order[i] == i;
+    }
+
+    if (inPlace) {
+        // Points only move towards the front, so that they can be overwritten as they are read
+        size_t next = 0;
+        const auto move = [&](size_t from) {
+            pointLevel._points[next] = pointLevel._points[from];
+            pointLevel._diameters[next] = pointLevel._diameters[from];
+            if (hasPerimeters) {
+                pointLevel._perimeters[next] = pointLevel._perimeters[from];
+            }
+            ++next;
+        };
+        for (uint32_t id = 0; id < sectionCount; ++id) {
+            const Kept range = kept(id);
+            sections[id][0] = static_cast<int>(next);
+            if (range.endsOnly) {
+                move(range.begin);
+                move(range.end - 1);
+            } else {
+                for (size_t p = range.begin; p < range.end; ++p) {
+                    move(p);
+                }
+            }
+        }
+        pointLevel._points.resize(next);
+        pointLevel._diameters.resize(next);
+        if (hasPerimeters) {
+            pointLevel._perimeters.resize(next);
+        }
+        return;
+    }
+
+    std::vector<int32_t> newIds(sectionCount);
+    size_t keptCount = 0;
+    for (uint32_t i = 0; i < sectionCount; ++i) {
+        newIds[order[i]] = static_cast<int32_t>(i);
+        const Kept range = kept(order[i]);
+        keptCount += range.endsOnly ? 2 : range.end - range.begin;
+    }
+
+    Property::PointLevel newPointLevel;
+    newPointLevel._points.reserve(keptCount);
+    newPointLevel._diameters.reserve(keptCount);
+    if (hasPerimeters) {
+        newPointLevel._perimeters.reserve(keptCount);
+    }
+    const auto copy = [&](size_t from) {
+        newPointLevel._points.push_back(pointLevel._points[from]);
+        newPointLevel._diameters.push_back(pointLevel._diameters[from]);
+        if (hasPerimeters) {
+            newPointLevel._perimeters.push_back(pointLevel._perimeters[from]);
+        }
+    };
+
+    std::vector<Property::Section::Type> newSections(sectionCount);
+    std::vector<Property::SectionType::Type> newTypes(sectionCount);
+    for (uint32_t i = 0; i < sectionCount; ++i) {
+        const uint32_t id = order[i];
+        const int32_t parent = sections[id][1];
+        newSections[i] = {static_cast<int>(newPointLevel._points.size()),
+                          parent < 0 ? -1 : newIds[static_cast<size_t>(parent)]};
+        newTypes[i] = types[id];
+        const Kept range = kept(id);
+        if (range.endsOnly) {
+            copy(range.begin);
+            copy(range.end - 1);
+        } else {
+            for (size_t p = range.begin; p < range.end; ++p) {
+                copy(p);
+            }
+        }
+    }
+
+    pointLevel._points = std::move(newPointLevel._points);
+    pointLevel._diameters = std::move(newPointLevel._diameters);
+    pointLevel._perimeters = std::move(newPointLevel._perimeters);
+    sections = std::move(newSections);
+    types = std::move(newTypes);
+
+    // The organelles refer to the neuronal sections by ID
+    for (auto& id : properties._mitochondriaPointLevel._sectionIds) {
+        id = static_cast<uint32_t>(newIds[id]);
+    }
+    for (auto& id : properties._endoplasmicReticulumLevel._sectionIndices) {
+        id = static_cast<uint32_t>(newIds[id]);
+    }
+}
+
+}  // namespace
+
+void somaSphere(Property::PointLevel& soma) {
+    const auto size = static_cast<floatType>(soma._points.size());
+
+    if (size < 2) {
+        return;
+    }
+
+    floatType x = 0;
+    floatType y = 0;
+    floatType z = 0;
+    floatType r = 0;
+
+    for (const Point& point : soma._points) {
+        x += point[0] / size;
+        y += point[1] / size;
+        z += point[2] / size;
+    }
+
+    for (const Point& point : soma._points) {
+#ifdef MORPHIO_USE_DOUBLE
+        r += sqrt(pow(point[0] - x, 2) + pow(point[1] - y, 2) + pow(point[2] - z, 2)) / size;
+#else
+        r += sqrtf(powf(point[0] - x, 2) + powf(point[1] - y, 2) + powf(point[2] - z, 2)) / size;
+#endif
+    }
+
+    soma._points = {{x, y, z}};
+    soma._diameters = {r};
+}
+
+void applyModifiers(Property::Properties& properties,
+                    unsigned int options,
+                    const readers::ErrorMessages& err) {
+    if (options & NO_DUPLICATES & TWO_POINTS_SECTIONS) {
+        throw SectionBuilderError(err.ERROR_UNCOMPATIBLE_FLAGS(NO_DUPLICATES, TWO_POINTS_SECTIONS));
+    }
+
+    if (options & SOMA_SPHERE) {
+        somaSphere(properties._somaLevel);
+    }
+
+    if (!(options & (NO_DUPLICATES | TWO_POINTS_SECTIONS | NRN_ORDER))) {
+        return;
+    }
+
+    std::vector<uint32_t> order;
+    if (options & NRN_ORDER) {
+        order = nrnOrder(properties);
+    } else {
+        order.resize(properties._sectionLevel._sections.size());
+        for (uint32_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+    }
+    compactSections(properties, options, order);
+}
+
+}  // namespace modifiers
+}  // namespace morphio
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <morphio/errorMessages.h>
+#include <morphio/properties.h>
+
+namespace morphio {
+namespace modifiers {
+
+/**
+ * Reduce the soma to a sphere placed at the center of gravity of its points, whose radius is
+ * the average distance between the points and the center of gravity
+ */
+void somaSphere(Property::PointLevel& soma);
+
+/**
+ * Apply the modifiers `options` straight on `properties`, with the same result as
+ * mut::Morphology::applyModifiers followed by buildReadOnly.
+ *
+ * The points of the sections are compacted in place. Only NRN_ORDER, which renumbers the
+ * sections depth first from the sorted roots, copies them into new arrays.
+ */
+void applyModifiers(Property::Properties& properties,
+                    unsigned int options,
+                    const readers::ErrorMessages& err = readers::ErrorMessages());
+
+}  // namespace modifiers
+}  // namespace morphio
@@ -2,15 +2,18 @@
 #include <fstream>
 #include <iterator>  // std::back_inserter
 #include <memory>
+#include <utility>  // std::move
 
 #include <morphio/endoplasmic_reticulum.h>
 #include <morphio/mitochondria.h>
 #include <morphio/morphology.h>
 #include <morphio/section.h>
+#include <morphio/section_view.h>
 #include <morphio/soma.h>
 
 #include <morphio/mut/morphology.h>
 
+#include "modifiers.h"
 #include "readers/morphologyASC.h"
 #include "readers/morphologyHDF5.h"
 #include "readers/morphologySWC.h"
@@ -31,25 +34,10 @@ std::string readCompleteFile(const std::string& path) {
 }
 
 void buildChildren(const std::shared_ptr<morphio::Property::Properties>& properties) {
-    {
-        const auto& sections = properties->get<morphio::Property::Section>();
-        auto& children = properties->_sectionLevel._children;
-
-        for (unsigned int i = 0; i < sections.size(); ++i) {
-            const int32_t parent = sections[i][1];
-            children[parent].push_back(i);
-        }
-    }
-
-    {
-        const auto& sections = properties->get<morphio::Property::MitoSection>();
-        auto& children = properties->_mitochondriaSectionLevel._children;
-
-        for (unsigned int i = 0; i < sections.size(); ++i) {
-            const int32_t parent = sections[i][1];
-            children[parent].push_back(i);
-        }
-    }
+    properties->_sectionLevel._children = morphio::Property::ChildrenTable(
+        properties->get<morphio::Property::Section>());
+    properties->_mitochondriaSectionLevel._children = morphio::Property::ChildrenTable(
+        properties->get<morphio::Property::MitoSection>());
 }
 
 morphio::SomaType getSomaType(long unsigned int num_soma_points) {
@@ -116,22 +104,19 @@ morphio::Property::Properties loadString(const std::string& contents,
 
 namespace morphio {
 
-Morphology::Morphology(const Property::Properties& properties, unsigned int options)
-    : properties_(std::make_shared<Property::Properties>(properties)) {
-    buildChildren(properties_);
-
+Morphology::Morphology(Property::Properties properties, unsigned int options)
+    : properties_(std::make_shared<Property::Properties>(std::move(properties))) {
     if (properties_->_cellLevel.fileFormat() != "swc") {
         properties_->_cellLevel._somaType = getSomaType(soma().points().size());
     }
 
     // For SWC and ASC, sanitization and modifier application are already taken care of by
     // their respective loaders
-    if (properties._cellLevel.fileFormat() == "h5" && options) {
-        mut::Morphology mutable_morph(*this);
-        mutable_morph.applyModifiers(options);
-        properties_ = std::make_shared<Property::Properties>(mutable_morph.buildReadOnly());
-        buildChildren(properties_);
+    if (properties_->_cellLevel.fileFormat() == "h5" && options) {
+        modifiers::applyModifiers(*properties_, options);
     }
+
+    buildChildren(properties_);
 }
 
 Morphology::Morphology(const std::string& path, unsigned int options)
@@ -140,8 +125,11 @@ Morphology::Morphology(const std::string& path, unsigned int options)
 Morphology::Morphology(const HighFive::Group& group, unsigned int options)
     : Morphology(readers::h5::load(group), options) {}
 
-Morphology::Morphology(const mut::Morphology& morphology) {
-    properties_ = std::make_shared<Property::Properties>(morphology.buildReadOnly());
+Morphology::Morphology(const mut::Morphology& morphology)
+    : Morphology(std::make_shared<Property::Properties>(morphology.buildReadOnly())) {}
+
+Morphology::Morphology(std::shared_ptr<Property::Properties> properties)
+    : properties_(std::move(properties)) {
     buildChildren(properties_);
 }
 
@@ -174,16 +162,24 @@ Section Morphology::section(uint32_t id) const {
     return {id, properties_};
 }
 
-std::vector<Section> Morphology::rootSections() const {
-    const auto& sections = properties_->children<morphio::Property::Section>();
-
-    if (sections.empty()) {
-        return {};
+SectionView Morphology::sectionView(uint32_t id) const {
+    const auto count = properties_->get<Property::Section>().size();
+    if (id >= count) {
+        throw RawDataError("Requested section ID (" + std::to_string(id) +
+                           ") is out of array bounds (array size = " + std::to_string(count) +
+                           ")");
     }
+    return {id, properties_.get()};
+}
 
-    std::vector<Section> result;
+SectionViewRange Morphology::rootSectionViews() const noexcept {
+    return {properties_->children<Property::Section>().roots(), properties_.get()};
+}
+
+std::vector<Section> Morphology::rootSections() const {
+    const auto children = properties_->children<morphio::Property::Section>().roots();
 
-    const std::vector<uint32_t>& children = sections.at(-1);
+    std::vector<Section> result;
     result.reserve(children.size());
     for (auto id : children) {
         result.push_back(section(id));
@@ -212,6 +208,14 @@ const Points& Morphology::points() const noexcept {
     return get<Property::Point>();
 }
 
+PointsSoAView Morphology::pointsSoA() const {
+    return properties_->pointsSoA().view();
+}
+
+const std::vector<floatType>& Morphology::pathDistances() const {
+    return properties_->pathDistances()._points;
+}
+
 std::vector<uint32_t> Morphology::sectionOffsets() const {
     const std::vector<Property::Section::Type>& indices_and_parents = get<Property::Section>();
     auto size = indices_and_parents.size();
@@ -245,7 +249,7 @@ const SomaType& Morphology::somaType() const {
 }
 
 const std::map<int, std::vector<unsigned int>>& Morphology::connectivity() const {
-    return properties_->children<Property::Section>();
+    return properties_->connectivity<Property::Section>();
 }
 
 const MorphologyVersion& Morphology::version() const {
@@ -253,7 +257,7 @@ const MorphologyVersion& Morphology::version() const {
 }
 
 depth_iterator Morphology::depth_begin() const {
-    return depth_iterator(*this);
+    return depth_iterator(properties_, properties_->traversal<Property::Section>()._depthFirst);
 }
 
 depth_iterator Morphology::depth_end() const {
@@ -261,7 +265,8 @@ depth_iterator Morphology::depth_end() const {
 }
 
 breadth_iterator Morphology::breadth_begin() const {
-    return breadth_iterator(*this);
+    return breadth_iterator(properties_,
+                            properties_->traversal<Property::Section>()._breadthFirst);
 }
 
 breadth_iterator Morphology::breadth_end() const {
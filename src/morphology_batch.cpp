@@ -0,0 +1,92 @@
+#include <morphio/morphology_batch.h>
+
+namespace morphio {
+
+MorphologyBatch::MorphologyBatch()
+    : _sectionOffsets{0}
+    , _cellSectionOffsets{0}
+    , _cellPointOffsets{0}
+    , _cellSomaPointOffsets{0} {}
+
+void MorphologyBatch::append(const Morphology& morphology) {
+    const Property::Properties& properties = *morphology.properties_;
+    const Property::PointLevel& pointLevel = properties._pointLevel;
+    const Property::PointLevel& somaLevel = properties._somaLevel;
+    const bool hasPerimeters = pointLevel._perimeters.size() == pointLevel._points.size();
+
+    appendCell(pointLevel._points.data(),
+               pointLevel._diameters.data(),
+               hasPerimeters ? pointLevel._perimeters.data() : nullptr,
+               pointLevel._points.size(),
+               properties._sectionLevel._sections.data(),
+               properties._sectionLevel._sectionTypes.data(),
+               properties._sectionLevel._sections.size(),
+               somaLevel._points.data(),
+               somaLevel._diameters.data(),
+               somaLevel._points.size(),
+               properties._cellLevel._somaType);
+}
+
+void MorphologyBatch::reserve(size_t cellCount,
+                              size_t sectionCount,
+                              size_t pointCount,
+                              size_t somaPointCount) {
+    _points.reserve(pointCount);
+    _diameters.reserve(pointCount);
+    if (_hasPerimeters) {
+        _perimeters.reserve(pointCount);
+    }
+    _sectionOffsets.reserve(sectionCount + 1);
+    _sectionParents.reserve(sectionCount);
+    _sectionTypes.reserve(sectionCount);
+    _somaPoints.reserve(somaPointCount);
+    _somaDiameters.reserve(somaPointCount);
+    _somaTypes.reserve(cellCount);
+    _cellSectionOffsets.reserve(cellCount + 1);
+    _cellPointOffsets.reserve(cellCount + 1);
+    _cellSomaPointOffsets.reserve(cellCount + 1);
+}
+
+void MorphologyBatch::appendCell(const Point* points,
+                                 const floatType* diameters,
+                                 const floatType* perimeters,
+                                 size_t pointCount,
+                                 const Property::Section::Type* sections,
+                                 const SectionType* sectionTypes,
+                                 size_t sectionCount,
+                                 const Point* somaPoints,
+                                 const floatType* somaDiameters,
+                                 size_t somaPointCount,
+                                 SomaType somaType) {
+    const uint64_t pointOffset = _points.size();
+
+    _points.insert(_points.end(), points, points + pointCount);
+    _diameters.insert(_diameters.end(), diameters, diameters + pointCount);
+    if (perimeters == nullptr && pointCount > 0) {
+        // Perimeters are all or nothing, so that they stay aligned with the points
+        _hasPerimeters = false;
+        _perimeters.clear();
+        _perimeters.shrink_to_fit();
+    } else if (_hasPerimeters && perimeters != nullptr) {
+        _perimeters.insert(_perimeters.end(), perimeters, perimeters + pointCount);
+    }
+
+    // drop the trailing sentinel, it is pushed back after the sections of this cell
+    _sectionOffsets.pop_back();
+    for (size_t i = 0; i < sectionCount; ++i) {
+        _sectionOffsets.push_back(pointOffset + static_cast<uint64_t>(sections[i][0]));
+        _sectionParents.push_back(sections[i][1]);
+    }
+    _sectionOffsets.push_back(_points.size());
+    _sectionTypes.insert(_sectionTypes.end(), sectionTypes, sectionTypes + sectionCount);
+
+    _somaPoints.insert(_somaPoints.end(), somaPoints, somaPoints + somaPointCount);
+    _somaDiameters.insert(_somaDiameters.end(), somaDiameters, somaDiameters + somaPointCount);
+    _somaTypes.push_back(somaType);
+
+    _cellSectionOffsets.push_back(_sectionTypes.size());
+    _cellPointOffsets.push_back(_points.size());
+    _cellSomaPointOffsets.push_back(_somaPoints.size());
+}
+
+}  // namespace morphio
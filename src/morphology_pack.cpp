@@ -0,0 +1,626 @@
+#include <algorithm>  // std::copy_n, std::find, std::min
+#include <array>
+#include <cstdint>
+#include <cstring>  // std::memcmp, std::memcpy
+#include <fstream>
+#include <unordered_map>
+#include <utility>  // std::move
+
+#ifndef _WIN32
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+#endif
+
+#include <morphio/collection.h>
+#include <morphio/exceptions.h>
+#include <morphio/morphology_pack.h>
+#include <morphio/mut/morphology.h>
+
+#include "modifiers.h"
+
+namespace morphio {
+
+namespace {
+
+/*
+ * On-disk layout of a morphology pack (all integers in native byte order):
+ *
+ *   PackHeader                 at offset 0
+ *   data arrays                each aligned to `kAlignment` bytes
+ *   name table                 the concatenated morphology names
+ *   PackCellRecord[cellCount]  at `cellTableOffset`, aligned to `kAlignment` bytes
+ *
+ * The header is written last, so that a pack that was not completely written is
+ * rejected because of its missing signature.
+ */
+constexpr std::array<char, 8> kMagic = {{'M', 'O', 'R', 'P', 'H', 'P', 'K', '\0'}};
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr uint64_t kAlignment = 64;
+
+enum PackArrayId : uint32_t {
+    POINTS = 0,
+    DIAMETERS,
+    PERIMETERS,
+    SECTIONS,
+    SECTION_TYPES,
+    SOMA_POINTS,
+    SOMA_DIAMETERS,
+    SOMA_PERIMETERS,
+    MITO_SECTION_IDS,
+    MITO_PATH_LENGTHS,
+    MITO_DIAMETERS,
+    MITO_SECTIONS,
+    ER_SECTION_INDICES,
+    ER_VOLUMES,
+    ER_SURFACE_AREAS,
+    ER_FILAMENT_COUNTS,
+    POST_SYNAPTIC_DENSITIES,
+    ARRAY_COUNT
+};
+
+struct PackHeader {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t byteOrderMark;
+    uint32_t floatSize;
+    uint32_t arrayCount;
+    uint64_t cellCount;
+    uint64_t cellTableOffset;
+    uint64_t nameTableOffset;
+    uint64_t nameTableSize;
+    uint64_t reserved;
+};
+
+struct PackArray {
+    uint64_t offset;  // in bytes, from the start of the file
+    uint64_t count;   // in elements
+};
+
+struct PackCellRecord {
+    uint64_t nameOffset;  // in bytes, from the start of the name table
+    uint32_t nameLength;
+    uint32_t cellFamily;
+    char fileFormat[16];
+    uint32_t majorVersion;
+    uint32_t minorVersion;
+    uint32_t somaType;
+    uint32_t reserved;
+    PackArray arrays[ARRAY_COUNT];
+};
+
+static_assert(sizeof(PackHeader) == 64, "PackHeader must be 64 bytes");
+static_assert(sizeof(PackCellRecord) % 8 == 0, "PackCellRecord must be 8 bytes aligned");
+static_assert(sizeof(SectionType) == sizeof(uint32_t), "SectionType must be stored on 32 bits");
+
+uint64_t alignUp(uint64_t offset) {
+    return (offset + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+class PackWriter
+{
+  public:
+    explicit PackWriter(const std::string& path)
+        : _path(path)
+        , _stream(path, std::ios::binary | std::ios::trunc) {
+        if (!_stream) {
+            throw MorphioError("Unable to open morphology pack for writing: " + path);
+        }
+        // Reserve room for the header, filled in by `finalize`
+        const PackHeader header{};
+        write(&header, sizeof(header));
+    }
+
+    template <typename T>
+    PackArray writeArray(const std::vector<T>& data) {
+        pad();
+        const PackArray array{_offset, static_cast<uint64_t>(data.size())};
+        write(data.data(), data.size() * sizeof(T));
+        return array;
+    }
+
+    uint64_t writeBytes(const std::string& data) {
+        const uint64_t offset = _offset;
+        write(data.data(), data.size());
+        return offset;
+    }
+
+    void finalize(const std::vector<PackCellRecord>& cells,
+                  uint64_t nameTableOffset,
+                  uint64_t nameTableSize) {
+        pad();
+        const uint64_t cellTableOffset = _offset;
+        write(cells.data(), cells.size() * sizeof(PackCellRecord));
+
+        PackHeader header{};
+        std::copy(kMagic.begin(), kMagic.end(), header.magic);
+        header.formatVersion = kFormatVersion;
+        header.byteOrderMark = kByteOrderMark;
+        header.floatSize = sizeof(floatType);
+        header.arrayCount = ARRAY_COUNT;
+        header.cellCount = cells.size();
+        header.cellTableOffset = cellTableOffset;
+        header.nameTableOffset = nameTableOffset;
+        header.nameTableSize = nameTableSize;
+
+        _stream.seekp(0);
+        _stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        _stream.flush();
+        if (!_stream) {
+            throw MorphioError("Failed to write morphology pack: " + _path);
+        }
+    }
+
+  private:
+    void write(const void* data, size_t size) {
+        if (size == 0) {
+            return;
+        }
+        _stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!_stream) {
+            throw MorphioError("Failed to write morphology pack: " + _path);
+        }
+        _offset += size;
+    }
+
+    void pad() {
+        static const std::array<char, kAlignment> zeros{};
+        write(zeros.data(), alignUp(_offset) - _offset);
+    }
+
+    std::string _path;
+    std::ofstream _stream;
+    uint64_t _offset = 0;
+};
+
+/** A read-only mapping of a whole file */
+class MappedFile
+{
+  public:
+    explicit MappedFile(const std::string& path) {
+#ifndef _WIN32
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw RawDataError("File: " + path + " does not exist.");
+        }
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw RawDataError("Unable to stat morphology pack: " + path);
+        }
+        _size = static_cast<size_t>(info.st_size);
+        if (_size > 0) {
+            void* address = ::mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+            if (address == MAP_FAILED) {
+                ::close(fd);
+                throw RawDataError("Unable to map morphology pack: " + path);
+            }
+            _data = static_cast<const char*>(address);
+        }
+        ::close(fd);
+#else
+        std::ifstream stream(path, std::ios::binary | std::ios::ate);
+        if (!stream) {
+            throw RawDataError("File: " + path + " does not exist.");
+        }
+        _size = static_cast<size_t>(stream.tellg());
+        _buffer.resize(_size);
+        stream.seekg(0);
+        stream.read(_buffer.data(), static_cast<std::streamsize>(_size));
+        _data = _buffer.data();
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (_data != nullptr) {
+            ::munmap(const_cast<char*>(_data), _size);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const noexcept {
+        return _data;
+    }
+
+    size_t size() const noexcept {
+        return _size;
+    }
+
+  private:
+    const char* _data = nullptr;
+    size_t _size = 0;
+#ifdef _WIN32
+    std::vector<char> _buffer;
+#endif
+};
+
+bool hasMagic(const char* data) {
+    return std::memcmp(data, kMagic.data(), kMagic.size()) == 0;
+}
+
+}  // namespace
+
+class MorphologyPackImpl
+{
+  public:
+    explicit MorphologyPackImpl(const std::string& path)
+        : _path(path)
+        , _file(path) {
+        if (_file.size() < sizeof(PackHeader) || !hasMagic(_file.data())) {
+            throw RawDataError("Not a morphology pack: " + path);
+        }
+
+        std::memcpy(&_header, _file.data(), sizeof(PackHeader));
+        if (_header.formatVersion != kFormatVersion) {
+            throw RawDataError("Unsupported morphology pack version " +
+                               std::to_string(_header.formatVersion) + " in: " + path);
+        }
+        if (_header.byteOrderMark != kByteOrderMark) {
+            throw RawDataError("Morphology pack written with a different byte order: " + path);
+        }
+        if (_header.floatSize != sizeof(floatType)) {
+            throw RawDataError(
+                "Morphology pack written with " + std::to_string(8 * _header.floatSize) +
+                " bit floats, MorphIO uses " + std::to_string(8 * sizeof(floatType)) +
+                " bit floats: " + path);
+        }
+        if (_header.arrayCount != ARRAY_COUNT) {
+            throw RawDataError("Unexpected number of arrays in morphology pack: " + path);
+        }
+        if (!inBounds(_header.cellTableOffset, _header.cellCount, sizeof(PackCellRecord)) ||
+            _header.cellTableOffset % alignof(PackCellRecord) != 0 ||
+            !inBounds(_header.nameTableOffset, _header.nameTableSize, 1)) {
+            throw RawDataError("Corrupted morphology pack: " + path);
+        }
+
+        _cells = reinterpret_cast<const PackCellRecord*>(_file.data() + _header.cellTableOffset);
+        _names.reserve(_header.cellCount);
+        const char* nameTable = _file.data() + _header.nameTableOffset;
+        for (size_t i = 0; i < _header.cellCount; ++i) {
+            const PackCellRecord& cell = _cells[i];
+            if (cell.nameOffset + cell.nameLength > _header.nameTableSize) {
+                throw RawDataError("Corrupted morphology pack: " + path);
+            }
+            _names.emplace_back(nameTable + cell.nameOffset, cell.nameLength);
+            _index.emplace(_names.back(), i);
+        }
+    }
+
+    const std::vector<std::string>& names() const noexcept {
+        return _names;
+    }
+
+    size_t index(const std::string& name) const {
+        const auto it = _index.find(name);
+        if (it == _index.end()) {
+            throw MorphioError("Morphology '" + name + "' not found in: " + _path);
+        }
+        return it->second;
+    }
+
+    bool contains(const std::string& name) const {
+        return _index.count(name) > 0;
+    }
+
+    const PackCellRecord& cell(size_t index) const {
+        if (index >= _names.size()) {
+            throw MorphioError("Morphology index " + std::to_string(index) +
+                               " is out of range in: " + _path);
+        }
+        return _cells[index];
+    }
+
+    /**
+     * Return the record of the cell at `index`, once its arrays are checked to be consistent:
+     * the readers of its sections then stay within the arrays
+     */
+    const PackCellRecord& checkedCell(size_t index) const {
+        const PackCellRecord& record = cell(index);
+        const auto& arrays = record.arrays;
+        const uint64_t nPoints = arrays[POINTS].count;
+        const uint64_t nSomaPoints = arrays[SOMA_POINTS].count;
+        const uint64_t nMitoPoints = arrays[MITO_DIAMETERS].count;
+        const uint64_t nReticulum = arrays[ER_SECTION_INDICES].count;
+        const auto optional = [](const PackArray& array, uint64_t count) {
+            return array.count == 0 || array.count == count;
+        };
+        if (arrays[DIAMETERS].count != nPoints || !optional(arrays[PERIMETERS], nPoints) ||
+            arrays[SECTION_TYPES].count != arrays[SECTIONS].count ||
+            arrays[SOMA_DIAMETERS].count != nSomaPoints ||
+            !optional(arrays[SOMA_PERIMETERS], nSomaPoints) ||
+            arrays[MITO_SECTION_IDS].count != nMitoPoints ||
+            arrays[MITO_PATH_LENGTHS].count != nMitoPoints ||
+            arrays[ER_VOLUMES].count != nReticulum ||
+            arrays[ER_SURFACE_AREAS].count != nReticulum ||
+            arrays[ER_FILAMENT_COUNTS].count != nReticulum) {
+            throw RawDataError("Corrupted morphology pack: inconsistent array sizes in: " +
+                               _path);
+        }
+        checkOffsets(arrays[SECTIONS], nPoints);
+        checkOffsets(arrays[MITO_SECTIONS], nMitoPoints);
+        return record;
+    }
+
+    Property::Properties properties(size_t index) const {
+        const PackCellRecord& record = checkedCell(index);
+
+        Property::Properties properties;
+        read(record.arrays[POINTS], properties._pointLevel._points);
+        read(record.arrays[DIAMETERS], properties._pointLevel._diameters);
+        read(record.arrays[PERIMETERS], properties._pointLevel._perimeters);
+        read(record.arrays[SECTIONS], properties._sectionLevel._sections);
+        read(record.arrays[SECTION_TYPES], properties._sectionLevel._sectionTypes);
+        read(record.arrays[SOMA_POINTS], properties._somaLevel._points);
+        read(record.arrays[SOMA_DIAMETERS], properties._somaLevel._diameters);
+        read(record.arrays[SOMA_PERIMETERS], properties._somaLevel._perimeters);
+        read(record.arrays[MITO_SECTION_IDS], properties._mitochondriaPointLevel._sectionIds);
+        read(record.arrays[MITO_PATH_LENGTHS],
+             properties._mitochondriaPointLevel._relativePathLengths);
+        read(record.arrays[MITO_DIAMETERS], properties._mitochondriaPointLevel._diameters);
+        read(record.arrays[MITO_SECTIONS], properties._mitochondriaSectionLevel._sections);
+        read(record.arrays[ER_SECTION_INDICES],
+             properties._endoplasmicReticulumLevel._sectionIndices);
+        read(record.arrays[ER_VOLUMES], properties._endoplasmicReticulumLevel._volumes);
+        read(record.arrays[ER_SURFACE_AREAS], properties._endoplasmicReticulumLevel._surfaceAreas);
+        read(record.arrays[ER_FILAMENT_COUNTS],
+             properties._endoplasmicReticulumLevel._filamentCounts);
+        read(record.arrays[POST_SYNAPTIC_DENSITIES],
+             properties._dendriticSpineLevel._post_synaptic_density);
+
+        // The field is not NUL terminated in a corrupted pack
+        const char* formatEnd = std::find(record.fileFormat,
+                                          record.fileFormat + sizeof(record.fileFormat),
+                                          '\0');
+        properties._cellLevel._version = MorphologyVersion{std::string(record.fileFormat,
+                                                                       formatEnd),
+                                                           record.majorVersion,
+                                                           record.minorVersion};
+        properties._cellLevel._cellFamily = static_cast<CellFamily>(record.cellFamily);
+        properties._cellLevel._somaType = static_cast<SomaType>(record.somaType);
+
+        return properties;
+    }
+
+    template <typename T>
+    range<const T> view(const PackArray& array) const {
+        return {this->array<T>(array), static_cast<size_t>(array.count)};
+    }
+
+    /** Return a pointer to the mapped elements of `array`, nullptr if it is empty */
+    template <typename T>
+    const T* array(const PackArray& array) const {
+        if (array.count == 0) {
+            return nullptr;
+        }
+        if (!inBounds(array.offset, array.count, sizeof(T)) || array.offset % alignof(T) != 0) {
+            throw RawDataError("Corrupted morphology pack: " + _path);
+        }
+        return reinterpret_cast<const T*>(_file.data() + array.offset);
+    }
+
+  private:
+    bool inBounds(uint64_t offset, uint64_t count, uint64_t elementSize) const {
+        return offset <= _file.size() && count <= (_file.size() - offset) / elementSize;
+    }
+
+    /** Check that the sections of `array` start in order, within the `count` points */
+    void checkOffsets(const PackArray& array, uint64_t count) const {
+        const auto* sections = this->array<Property::Section::Type>(array);
+        int previous = 0;
+        for (uint64_t i = 0; i < array.count; ++i) {
+            const int start = sections[i][0];
+            if (start < previous || static_cast<uint64_t>(start) > count) {
+                throw RawDataError("Corrupted morphology pack: section " + std::to_string(i) +
+                                   " starts at point " + std::to_string(start) +
+                                   " in: " + _path);
+            }
+            previous = start;
+        }
+    }
+
+    template <typename T>
+    void read(const PackArray& array, std::vector<T>& data) const {
+        const T* begin = this->array<T>(array);
+        data.assign(begin, begin + array.count);
+    }
+
+    std::string _path;
+    MappedFile _file;
+    PackHeader _header{};
+    const PackCellRecord* _cells = nullptr;
+    std::vector<std::string> _names;
+    std::unordered_map<std::string, size_t> _index;
+};
+
+MorphologyPack::MorphologyPack(const std::string& path)
+    : _impl(std::make_shared<const MorphologyPackImpl>(path)) {}
+
+size_t MorphologyPack::size() const noexcept {
+    return _impl->names().size();
+}
+
+const std::vector<std::string>& MorphologyPack::names() const noexcept {
+    return _impl->names();
+}
+
+bool MorphologyPack::contains(const std::string& name) const {
+    return _impl->contains(name);
+}
+
+size_t MorphologyPack::index(const std::string& name) const {
+    return _impl->index(name);
+}
+
+PackedMorphology MorphologyPack::view(const std::string& name) const {
+    return view(_impl->index(name));
+}
+
+PackedMorphology MorphologyPack::view(size_t index) const {
+    const PackCellRecord& record = _impl->checkedCell(index);
+    const auto& arrays = record.arrays;
+
+    PackedMorphology morphology;
+    morphology.points = _impl->view<Point>(arrays[POINTS]);
+    morphology.diameters = _impl->view<floatType>(arrays[DIAMETERS]);
+    morphology.perimeters = _impl->view<floatType>(arrays[PERIMETERS]);
+    morphology.sections = _impl->view<Property::Section::Type>(arrays[SECTIONS]);
+    morphology.sectionTypes = _impl->view<SectionType>(arrays[SECTION_TYPES]);
+    morphology.somaPoints = _impl->view<Point>(arrays[SOMA_POINTS]);
+    morphology.somaDiameters = _impl->view<floatType>(arrays[SOMA_DIAMETERS]);
+    morphology.somaType = static_cast<SomaType>(record.somaType);
+    morphology.cellFamily = static_cast<CellFamily>(record.cellFamily);
+    morphology.owner = _impl;
+    return morphology;
+}
+
+Morphology MorphologyPack::load(const std::string& name, unsigned int options) const {
+    return load(_impl->index(name), options);
+}
+
+Morphology MorphologyPack::load(size_t index, unsigned int options) const {
+    // Options are applied on top of the modifiers the pack may have been written with, the
+    // way the reader of the original format does: H5 cells keep the soma type they had
+    // before, the others get the one of their new soma
+    Property::Properties properties = _impl->properties(index);
+    if (properties._cellLevel.fileFormat() == "h5") {
+        return Morphology(std::move(properties), options);
+    }
+    if (options) {
+        modifiers::applyModifiers(properties, options);
+        if ((options & SOMA_SPHERE) && properties._somaLevel._points.size() == 1) {
+            properties._cellLevel._somaType = SOMA_SINGLE_POINT;
+        }
+    }
+    return Morphology(std::move(properties), NO_MODIFIER);
+}
+
+MorphologyBatch MorphologyPack::loadBatch(const std::vector<std::string>& names,
+                                          unsigned int options) const {
+    MorphologyBatch batch;
+
+    if (options) {
+        for (const auto& name : names) {
+            batch.append(load(name, options));
+        }
+        return batch;
+    }
+
+    std::vector<const PackCellRecord*> records;
+    records.reserve(names.size());
+    size_t sectionCount = 0;
+    size_t pointCount = 0;
+    size_t somaPointCount = 0;
+    for (const auto& name : names) {
+        const PackCellRecord& record = _impl->checkedCell(_impl->index(name));
+        sectionCount += record.arrays[SECTIONS].count;
+        pointCount += record.arrays[POINTS].count;
+        somaPointCount += record.arrays[SOMA_POINTS].count;
+        records.push_back(&record);
+    }
+    batch.reserve(names.size(), sectionCount, pointCount, somaPointCount);
+
+    for (const PackCellRecord* record : records) {
+        const auto& arrays = record->arrays;
+        const size_t nPoints = arrays[POINTS].count;
+        const size_t nSections = arrays[SECTIONS].count;
+        const size_t nSomaPoints = arrays[SOMA_POINTS].count;
+        const bool hasPerimeters = arrays[PERIMETERS].count == nPoints;
+
+        batch.appendCell(_impl->array<Point>(arrays[POINTS]),
+                         _impl->array<floatType>(arrays[DIAMETERS]),
+                         hasPerimeters ? _impl->array<floatType>(arrays[PERIMETERS]) : nullptr,
+                         nPoints,
+                         _impl->array<Property::Section::Type>(arrays[SECTIONS]),
+                         _impl->array<SectionType>(arrays[SECTION_TYPES]),
+                         nSections,
+                         _impl->array<Point>(arrays[SOMA_POINTS]),
+                         _impl->array<floatType>(arrays[SOMA_DIAMETERS]),
+                         nSomaPoints,
+                         static_cast<SomaType>(record->somaType));
+    }
+
+    return batch;
+}
+
+size_t MorphologyPack::offset(size_t index) const {
+    return _impl->cell(index).arrays[POINTS].offset;
+}
+
+void MorphologyPack::write(const std::string& path,
+                           const Collection& collection,
+                           const std::vector<std::string>& names,
+                           unsigned int options) {
+    PackWriter writer(path);
+    std::vector<PackCellRecord> cells;
+    cells.reserve(names.size());
+
+    for (const auto& name : names) {
+        const Morphology morphology = collection.load<Morphology>(name, options);
+        const Property::Properties& properties = *morphology.properties_;
+        const Property::CellLevel& cellLevel = properties._cellLevel;
+
+        PackCellRecord record{};
+        const std::string fileFormat = cellLevel.fileFormat();
+        std::copy_n(fileFormat.begin(),
+                    std::min(fileFormat.size(), sizeof(record.fileFormat) - 1),
+                    record.fileFormat);
+        record.majorVersion = std::get<1>(cellLevel._version);
+        record.minorVersion = std::get<2>(cellLevel._version);
+        record.cellFamily = static_cast<uint32_t>(cellLevel._cellFamily);
+        record.somaType = static_cast<uint32_t>(cellLevel._somaType);
+
+        auto& arrays = record.arrays;
+        arrays[POINTS] = writer.writeArray(properties._pointLevel._points);
+        arrays[DIAMETERS] = writer.writeArray(properties._pointLevel._diameters);
+        arrays[PERIMETERS] = writer.writeArray(properties._pointLevel._perimeters);
+        arrays[SECTIONS] = writer.writeArray(properties._sectionLevel._sections);
+        arrays[SECTION_TYPES] = writer.writeArray(properties._sectionLevel._sectionTypes);
+        arrays[SOMA_POINTS] = writer.writeArray(properties._somaLevel._points);
+        arrays[SOMA_DIAMETERS] = writer.writeArray(properties._somaLevel._diameters);
+        arrays[SOMA_PERIMETERS] = writer.writeArray(properties._somaLevel._perimeters);
+        arrays[MITO_SECTION_IDS] = writer.writeArray(
+            properties._mitochondriaPointLevel._sectionIds);
+        arrays[MITO_PATH_LENGTHS] = writer.writeArray(
+            properties._mitochondriaPointLevel._relativePathLengths);
+        arrays[MITO_DIAMETERS] = writer.writeArray(properties._mitochondriaPointLevel._diameters);
+        arrays[MITO_SECTIONS] = writer.writeArray(properties._mitochondriaSectionLevel._sections);
+        arrays[ER_SECTION_INDICES] = writer.writeArray(
+            properties._endoplasmicReticulumLevel._sectionIndices);
+        arrays[ER_VOLUMES] = writer.writeArray(properties._endoplasmicReticulumLevel._volumes);
+        arrays[ER_SURFACE_AREAS] = writer.writeArray(
+            properties._endoplasmicReticulumLevel._surfaceAreas);
+        arrays[ER_FILAMENT_COUNTS] = writer.writeArray(
+            properties._endoplasmicReticulumLevel._filamentCounts);
+        arrays[POST_SYNAPTIC_DENSITIES] = writer.writeArray(
+            properties._dendriticSpineLevel._post_synaptic_density);
+
+        cells.push_back(record);
+    }
+
+    std::string nameTable;
+    for (size_t i = 0; i < names.size(); ++i) {
+        cells[i].nameOffset = nameTable.size();
+        cells[i].nameLength = static_cast<uint32_t>(names[i].size());
+        nameTable += names[i];
+    }
+    const uint64_t nameTableOffset = writer.writeBytes(nameTable);
+
+    writer.finalize(cells, nameTableOffset, nameTable.size());
+}
+
+bool MorphologyPack::isPack(const std::string& path) {
+    std::ifstream stream(path, std::ios::binary);
+    std::array<char, kMagic.size()> magic{};
+    if (!stream.read(magic.data(), magic.size())) {
+        return false;
+    }
+    return hasMagic(magic.data());
+}
+
+}  // namespace morphio
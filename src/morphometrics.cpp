@@ -0,0 +1,130 @@
+#include <cmath>  // std::sqrt
+
+#include <morphio/morphology.h>
+#include <morphio/morphometrics.h>
+#include <morphio/points_soa.h>
+
+#include "thread_pool.h"
+
+namespace morphio {
+namespace {
+
+/**
+ * Fill the segment values of all consecutive point pairs of `soa`, section boundaries
+ * included: the loop has no branch so that it can be vectorized
+ */
+void computeSegments(const PointsSoAView& soa, Morphometrics& result) {
+    const size_t n = soa.size();
+    result.segmentLengths.assign(n, 0);
+    result.segmentAreas.assign(n, 0);
+    result.segmentVolumes.assign(n, 0);
+    if (n < 2 || soa.diameters.size() != n) {
+        return;
+    }
+
+    const floatType* const x = soa.x.data();
+    const floatType* const y = soa.y.data();
+    const floatType* const z = soa.z.data();
+    const floatType* const d = soa.diameters.data();
+    floatType* const lengths = result.segmentLengths.data();
+    floatType* const areas = result.segmentAreas.data();
+    floatType* const volumes = result.segmentVolumes.data();
+
+    for (size_t i = 0; i < n - 1; ++i) {
+        const floatType dx = x[i + 1] - x[i];
+        const floatType dy = y[i + 1] - y[i];
+        const floatType dz = z[i + 1] - z[i];
+        const floatType r0 = d[i] / 2;
+        const floatType r1 = d[i + 1] / 2;
+        const floatType dr = r1 - r0;
+        const floatType squaredLength = dx * dx + dy * dy + dz * dz;
+
+        lengths[i] = std::sqrt(squaredLength);
+        areas[i] = PI * (r0 + r1) * std::sqrt(squaredLength + dr * dr);
+        volumes[i] = PI / 3 * lengths[i] * (r0 * r0 + r0 * r1 + r1 * r1);
+    }
+}
+
+template <typename T>
+floatType sum(const std::vector<floatType>& values, T ids) {
+    floatType total = 0;
+    for (auto id : ids) {
+        total += values[id];
+    }
+    return total;
+}
+
+}  // namespace
+
+Morphometrics computeMorphometrics(const Property::Properties& properties) {
+    Morphometrics result;
+    computeSegments(properties.pointsSoA().view(), result);
+
+    const auto& sections = properties.get<Property::Section>();
+    const size_t nSections = sections.size();
+    const size_t nPoints = result.segmentLengths.size();
+    result.sectionLengths.resize(nSections);
+    result.sectionAreas.resize(nSections);
+    result.sectionVolumes.resize(nSections);
+
+    for (size_t i = 0; i < nSections; ++i) {
+        const auto start = static_cast<size_t>(sections[i][0]);
+        const size_t end = i + 1 == nSections ? nPoints : static_cast<size_t>(sections[i + 1][0]);
+        if (start == end) {
+            continue;
+        }
+
+        // The pair joining the last point to the next section is not a segment
+        result.segmentLengths[end - 1] = 0;
+        result.segmentAreas[end - 1] = 0;
+        result.segmentVolumes[end - 1] = 0;
+
+        for (size_t p = start; p < end - 1; ++p) {
+            result.sectionLengths[i] += result.segmentLengths[p];
+            result.sectionAreas[i] += result.segmentAreas[p];
+            result.sectionVolumes[i] += result.segmentVolumes[p];
+        }
+    }
+
+    // The Properties built by mut::Morphology::buildReadOnly() have no children table yet
+    const Property::ChildrenTable* children = &properties.children<Property::Section>();
+    const Property::TraversalOrders* traversal = nullptr;
+    Property::ChildrenTable localChildren;
+    Property::TraversalOrders localTraversal;
+    if (nSections > 0 && children->_offsets.empty()) {
+        localChildren = Property::ChildrenTable(sections);
+        localTraversal = Property::TraversalOrders(localChildren);
+        children = &localChildren;
+        traversal = &localTraversal;
+    } else {
+        traversal = &properties.traversal<Property::Section>();
+    }
+
+    const auto roots = children->roots();
+    result.neuriteLengths.reserve(roots.size());
+    result.neuriteAreas.reserve(roots.size());
+    result.neuriteVolumes.reserve(roots.size());
+    for (auto root : roots) {
+        const auto subtree = traversal->depthFirst(root);
+        result.neuriteLengths.push_back(sum(result.sectionLengths, subtree));
+        result.neuriteAreas.push_back(sum(result.sectionAreas, subtree));
+        result.neuriteVolumes.push_back(sum(result.sectionVolumes, subtree));
+    }
+
+    return result;
+}
+
+Morphometrics computeMorphometrics(const Morphology& morphology) {
+    return computeMorphometrics(*morphology.properties_);
+}
+
+std::vector<Morphometrics> computeMorphometrics(const std::vector<Morphology>& morphologies,
+                                                size_t n_threads) {
+    std::vector<Morphometrics> result(morphologies.size());
+    detail::parallel_for(morphologies.size(), n_threads, [&](size_t i) {
+        result[i] = computeMorphometrics(morphologies[i]);
+    });
+    return result;
+}
+
+}  // namespace morphio
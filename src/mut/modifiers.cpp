@@ -1,74 +1,59 @@
 #include <algorithm>
 #include <cmath>
+#include <vector>
 #include <morphio/mut/modifiers.h>
 #include <morphio/mut/morphology.h>
+#include <morphio/mut/soma.h>
+
+#include "../modifiers.h"
+#include "../thread_pool.h"
 
 namespace morphio {
 namespace mut {
 namespace modifiers {
 
-void two_points_sections(morphio::mut::Morphology& morpho) {
-    for (auto it = morpho.depth_begin(); it != morpho.depth_end(); ++it) {
-        std::shared_ptr<Section> section = *it;
-        size_t size = section->points().size();
-        if (size < 2) {
-            continue;
-        }
-        section->points() = {section->points()[0], section->points()[size - 1]};
-        section->diameters() = {section->diameters()[0], section->diameters()[size - 1]};
-        if (!section->perimeters().empty()) {
-            section->perimeters() = {section->perimeters()[0], section->perimeters()[size - 1]};
-        }
+namespace {
+
+/**
+ * Call `f(section)` for every section of `morpho`, using `n_threads` threads.
+ *
+ * The sections are listed once up front; `f` must only modify the section it is given.
+ */
+template <typename F>
+void forEachSection(morphio::mut::Morphology& morpho, size_t n_threads, const F& f) {
+    std::vector<Section*> sections;
+    sections.reserve(morpho.sections().size());
+    for (const auto& it : morpho.sections()) {
+        sections.push_back(it.second.get());
     }
+    detail::parallel_for(sections.size(), n_threads, [&](size_t i) { f(*sections[i]); });
 }
 
-void no_duplicate_point(morphio::mut::Morphology& morpho) {
-    for (auto it = morpho.depth_begin(); it != morpho.depth_end(); ++it) {
-        std::shared_ptr<Section> section = *it;
-        size_t size = section->points().size();
+}  // namespace
 
-        if (size < 1 || (*it)->isRoot()) {
-            continue;
+void two_points_sections(morphio::mut::Morphology& morpho, size_t n_threads) {
+    forEachSection(morpho, n_threads, [](Section& section) {
+        if (section.pointCount() < 2) {
+            return;
         }
+        section.keepEnds();
+    });
+}
 
-        section->points().erase(section->points().begin());
-        section->diameters().erase(section->diameters().begin());
+void no_duplicate_point(morphio::mut::Morphology& morpho, size_t n_threads) {
+    forEachSection(morpho, n_threads, [](Section& section) {
+        size_t size = section.pointCount();
 
-        if (!section->perimeters().empty()) {
-            section->perimeters().erase(section->perimeters().begin());
+        if (size < 1 || section.isRoot()) {
+            return;
         }
-    }
+
+        section.keepPoints(1, size);
+    });
 }
 
 void soma_sphere(morphio::mut::Morphology& morpho) {
-    auto soma = morpho.soma();
-    const auto size = static_cast<morphio::floatType>(soma->points().size());
-
-    if (size < 2) {
-        return;
-    }
-
-    floatType x = 0;
-    floatType y = 0;
-    floatType z = 0;
-    floatType r = 0;
-
-    for (const Point& point : soma->points()) {
-        x += point[0] / size;
-        y += point[1] / size;
-        z += point[2] / size;
-    }
-
-    for (auto point : soma->points()) {
-#ifdef MORPHIO_USE_DOUBLE
-        r += sqrt(pow(point[0] - x, 2) + pow(point[1] - y, 2) + pow(point[2] - z, 2)) / size;
-#else
-        r += sqrtf(powf(point[0] - x, 2) + powf(point[1] - y, 2) + powf(point[2] - z, 2)) / size;
-#endif
-    }
-
-    soma->points() = {{x, y, z}};
-    soma->diameters() = {r};
+    morphio::modifiers::somaSphere(morpho.soma()->properties());
 }
 
 static bool NRN_order_comparator(std::shared_ptr<Section> a, std::shared_ptr<Section> b) {
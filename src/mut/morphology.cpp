@@ -1,9 +1,12 @@
-#include <algorithm>  // std::find_if
+#include <algorithm>  // std::copy, std::max
 #include <cassert>
 #include <cctype>    // std::tolower
+#include <cstddef>   // std::ptrdiff_t
+#include <cstdint>   // int64_t
 #include <iterator>  // std::back_inserter
 #include <sstream>
 #include <string>
+#include <utility>  // std::move, std::pair
 
 #include <morphio/endoplasmic_reticulum.h>
 #include <morphio/mitochondria.h>
@@ -14,21 +17,33 @@
 #include <morphio/soma.h>
 
 #include "../shared_utils.hpp"
+#include "../thread_pool.h"
 
 namespace {
 using SectionP = std::shared_ptr<morphio::mut::Section>;
 
-void insertSectionsBeforeSection(std::vector<SectionP>& sections_to_update,
-                                 const std::vector<SectionP>& sections,
-                                 const SectionP& target_section) {
-    auto is_equal = [&target_section](const SectionP& section) {
-        return (section->id() == target_section->id()) && section->hasSameShape(*target_section);
-    };
-
-    const auto it = std::find_if(sections_to_update.begin(), sections_to_update.end(), is_equal);
-
-    // Note that the section with section_id is not removed at this step
-    sections_to_update.insert(it, sections.begin(), sections.end());
+/**
+ * Append to `result` the sections of `sections` that are kept, replacing every deleted
+ * section by its own children, recursively
+ */
+void appendKeptSections(const std::vector<SectionP>& sections,
+                        const std::deque<std::vector<SectionP>>& children,
+                        const std::vector<bool>& deleted,
+                        std::vector<SectionP>& result) {
+    std::vector<std::pair<const std::vector<SectionP>*, size_t>> stack{{&sections, 0}};
+    while (!stack.empty()) {
+        auto& top = stack.back();
+        if (top.second == top.first->size()) {
+            stack.pop_back();
+            continue;
+        }
+        const SectionP& section = (*top.first)[top.second++];
+        if (deleted[section->id()]) {
+            stack.emplace_back(&children[section->id()], 0);
+        } else {
+            result.push_back(section);
+        }
+    }
 }
 
 void appendProperties(morphio::Property::PointLevel& to,
@@ -48,6 +63,9 @@ namespace morphio {
 namespace mut {
 
 using morphio::readers::ErrorMessages;
+
+constexpr uint32_t Morphology::noParent;
+
 Morphology::Morphology(const std::string& uri, unsigned int options)
     : Morphology(morphio::Morphology(uri, options)) {}
 
@@ -91,12 +109,15 @@ Morphology::Morphology(const morphio::Morphology& morphology, unsigned int optio
    Return false if there is no duplicate point
  **/
 bool _checkDuplicatePoint(const SectionP& parent, const SectionP& current) {
+    // The points are read without copying the data of sections taken from a read-only
+    // morphology
+    const size_t parentCount = parent->pointCount();
     // Weird edge case where parent is empty: skipping it
-    if (parent->points().empty()) {
+    if (parentCount == 0) {
         return true;
-    } else if (current->points().empty()) {
+    } else if (current->pointCount() == 0) {
         return false;
-    } else if (parent->points().back() != current->points().front()) {
+    } else if (parent->pointAt(parentCount - 1) != current->pointAt(0)) {
         return false;
     }
 
@@ -120,7 +141,7 @@ std::shared_ptr<Section> Morphology::appendRootSection(const morphio::Section& s
     _register(ptr);
     _rootSections.push_back(ptr);
 
-    const bool emptySection = ptr->points().empty();
+    const bool emptySection = ptr->pointCount() == 0;
     if (emptySection) {
         printError(Warning::APPENDING_EMPTY_SECTION, _err.WARNING_APPENDING_EMPTY_SECTION(ptr));
     }
@@ -139,7 +160,7 @@ std::shared_ptr<Section> Morphology::appendRootSection(const std::shared_ptr<Sec
     std::shared_ptr<Section> section_copy(new Section(this, _counter, *section_));
     _register(section_copy);
     _rootSections.push_back(section_copy);
-    const bool emptySection = section_copy->points().empty();
+    const bool emptySection = section_copy->pointCount() == 0;
     if (emptySection) {
         printError(Warning::APPENDING_EMPTY_SECTION,
                    _err.WARNING_APPENDING_EMPTY_SECTION(section_copy));
@@ -168,75 +189,206 @@ std::shared_ptr<Section> Morphology::appendRootSection(const Property::PointLeve
     return ptr;
 }
 
-uint32_t Morphology::_register(const std::shared_ptr<Section>& section_) {
-    if (_sections.count(section_->id()) > 0) {
-        throw SectionBuilderError("Section already exists");
+std::vector<std::shared_ptr<Section>> Morphology::appendSections(
+    const Property::PointLevel& pointProperties,
+    const std::vector<Property::Section::Type>& sections,
+    const std::vector<SectionType>& sectionTypes) {
+    const size_t pointCount = pointProperties._points.size();
+    const size_t perimeterCount = pointProperties._perimeters.size();
+    if (pointProperties._diameters.size() != pointCount ||
+        (perimeterCount != 0 && perimeterCount != pointCount)) {
+        throw SectionBuilderError("appendSections: the point, diameter and perimeter arrays "
+                                  "have different sizes");
+    }
+    if (sectionTypes.size() != sections.size()) {
+        throw SectionBuilderError("appendSections: got " + std::to_string(sections.size()) +
+                                  " sections but " + std::to_string(sectionTypes.size()) +
+                                  " section types");
+    }
+
+    const auto count = static_cast<uint32_t>(sections.size());
+    std::vector<uint32_t> childCounts(count, 0);
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto end = i + 1 == count ? static_cast<int64_t>(pointCount)
+                                        : static_cast<int64_t>(sections[i + 1][0]);
+        if (sections[i][0] < 0 || sections[i][0] > end || end > static_cast<int64_t>(pointCount)) {
+            throw SectionBuilderError("appendSections: section " + std::to_string(i) +
+                                      " has an invalid point offset");
+        }
+        const int parent = sections[i][1];
+        if (parent < -1 || parent >= static_cast<int>(i)) {
+            throw SectionBuilderError("appendSections: the parent of section " +
+                                      std::to_string(i) + " must be -1 or a previous section");
+        }
+        if (sectionTypes[i] == SECTION_SOMA) {
+            throw SectionBuilderError("Cannot create section with type soma");
+        }
+        if (parent >= 0) {
+            ++childCounts[static_cast<uint32_t>(parent)];
+        }
+    }
+
+    // All the containers are grown once, and the children lists allocated at their size
+    const uint32_t firstId = _counter;
+    _counter += count;
+    _sectionSlots.resize(_counter);
+    _parent.resize(_counter, noParent);
+    _children.resize(_counter);
+    for (uint32_t i = 0; i < count; ++i) {
+        _children[firstId + i].reserve(childCounts[i]);
+    }
+
+    std::vector<std::shared_ptr<Section>> result;
+    result.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t id = firstId + i;
+        const int parent = sections[i][1];
+        const SectionType type = parent >= 0 && sectionTypes[i] == SECTION_UNDEFINED
+                                     ? result[static_cast<uint32_t>(parent)]->type()
+                                     : sectionTypes[i];
+        const SectionRange range{static_cast<size_t>(sections[i][0]),
+                                 i + 1 == count ? pointCount
+                                                : static_cast<size_t>(sections[i + 1][0])};
+        std::shared_ptr<Section> section(
+            new Section(this, id, type, Property::PointLevel(pointProperties, range)));
+        _sectionSlots[id] = section;
+
+        const bool emptySection = section->points().empty();
+        if (emptySection) {
+            printError(Warning::APPENDING_EMPTY_SECTION,
+                       _err.WARNING_APPENDING_EMPTY_SECTION(section));
+        }
+
+        if (parent < 0) {
+            _rootSections.push_back(section);
+        } else {
+            const auto& parentSection = result[static_cast<uint32_t>(parent)];
+            if (!ErrorMessages::isIgnored(Warning::WRONG_DUPLICATE) && !emptySection &&
+                !_checkDuplicatePoint(parentSection, section)) {
+                printError(Warning::WRONG_DUPLICATE,
+                           _err.WARNING_WRONG_DUPLICATE(section, parentSection));
+            }
+            _parent[id] = parentSection->id();
+            _children[parentSection->id()].push_back(section);
+        }
+        result.push_back(std::move(section));
     }
-    _counter = std::max(_counter, section_->id()) + 1;
-    _sections[section_->id()] = section_;
-    return section_->id();
+    _sectionsStale.store(true, std::memory_order_relaxed);
+    return result;
 }
 
-Morphology::~Morphology() {
-    auto roots = _rootSections;  // Need to iterate on a copy
-    for (const auto& root : roots) {
-        deleteSection(root, true);
+const std::map<uint32_t, std::shared_ptr<Section>>& Morphology::sections() const {
+    if (_sectionsStale.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(_sectionsMutex);
+        if (_sectionsStale.load(std::memory_order_relaxed)) {
+            _sections.clear();
+            for (uint32_t id = 0; id < _sectionSlots.size(); ++id) {
+                if (_sectionSlots[id] != nullptr) {
+                    _sections.emplace_hint(_sections.end(), id, _sectionSlots[id]);
+                }
+            }
+            _sectionsStale.store(false, std::memory_order_release);
+        }
     }
+    return _sections;
 }
 
-void Morphology::eraseByValue(std::vector<std::shared_ptr<Section>>& vec,
-                              const std::shared_ptr<Section> section) {
-    if (section->morphology_ == this) {
-        section->morphology_ = nullptr;
-        section->id_ = 0xffffffff;
+uint32_t Morphology::_register(const std::shared_ptr<Section>& section_) {
+    const uint32_t id = section_->id();
+    if (_hasSection(id)) {
+        throw SectionBuilderError("Section already exists");
     }
-    vec.erase(std::remove(vec.begin(), vec.end(), section), vec.end());
+    _counter = std::max(_counter, id) + 1;
+    if (_sectionSlots.size() < _counter) {
+        _sectionSlots.resize(_counter);
+        _parent.resize(_counter, noParent);
+        _children.resize(_counter);
+    }
+    _sectionSlots[id] = section_;
+    _sectionsStale.store(true, std::memory_order_relaxed);
+    return id;
 }
 
+Morphology::~Morphology() {
+    // Sections may outlive their morphology: detach them all, the containers are then
+    // released without any bookkeeping
+    for (const auto& section : _sectionSlots) {
+        if (section) {
+            section->morphology_ = nullptr;
+            section->id_ = 0xffffffff;
+        }
+    }
+}
 
 void Morphology::deleteSection(const std::shared_ptr<Section> section_, bool recursive) {
-    if (!section_) {
+    if (!section_ || section_->morphology_ != this) {
         return;
     }
+    deleteSections({section_->id()}, recursive);
+}
 
-    if (recursive) {
-        // The deletion must start by the furthest leaves, otherwise you may cut
-        // the topology and forget to remove some sections
-        std::vector<std::shared_ptr<Section>> ids;
-        std::copy(section_->breadth_begin(), breadth_end(), std::back_inserter(ids));
-
-        for (auto it = ids.rbegin(); it != ids.rend(); ++it) {
-            deleteSection(*it, false);
+void Morphology::deleteSections(const std::vector<uint32_t>& sectionIds, bool recursive) {
+    std::vector<bool> deleted(_sectionSlots.size(), false);
+    std::vector<uint32_t> deletedIds;
+    for (uint32_t id : sectionIds) {
+        if (!_hasSection(id) || deleted[id]) {
+            continue;
         }
-    } else {
-        const auto section_id = section_->id();
-
-        // Careful not to use a reference here or you will face reference invalidation problem
-        // with vector resize
-        const auto children = section_->children();
-
-        if (section_->isRoot()) {
-            // put root section's children in its place
-            insertSectionsBeforeSection(_rootSections, children, section_);
-            eraseByValue(_rootSections, section_);
-        } else {
-            // set grandparent as section children's parent
-            for (const auto& child : children) {
-                _parent[child->id()] = _parent[section_id];
+        deleted[id] = true;
+        deletedIds.push_back(id);
+        if (!recursive) {
+            continue;
+        }
+        // Descendants already marked had their own subtree marked as well
+        for (size_t i = deletedIds.size() - 1; i < deletedIds.size(); ++i) {
+            for (const auto& child : _children[deletedIds[i]]) {
+                if (!deleted[child->id()]) {
+                    deleted[child->id()] = true;
+                    deletedIds.push_back(child->id());
+                }
             }
+        }
+    }
+    if (deletedIds.empty()) {
+        return;
+    }
 
-            auto& children_of_parent = _children[_parent[section_id]];
+    // Rebuild the children lists containing deleted sections: their kept descendants take
+    // their place
+    const auto rebuild = [&](std::vector<std::shared_ptr<Section>>& sections, uint32_t parentId) {
+        std::vector<std::shared_ptr<Section>> kept;
+        appendKeptSections(sections, _children, deleted, kept);
+        for (const auto& section : kept) {
+            _parent[section->id()] = parentId;
+        }
+        sections = std::move(kept);
+    };
 
-            // put grandchildren at the position of the deleted section
-            insertSectionsBeforeSection(children_of_parent, children, section_);
-            eraseByValue(children_of_parent, section_);
+    std::vector<bool> rebuilt(_sectionSlots.size(), false);
+    bool rootsRebuilt = false;
+    for (uint32_t id : deletedIds) {
+        const uint32_t parentId = _parent[id];
+        if (!_hasSection(parentId)) {
+            if (!rootsRebuilt) {
+                rebuild(_rootSections, noParent);
+                rootsRebuilt = true;
+            }
+        } else if (!deleted[parentId] && !rebuilt[parentId]) {
+            rebuild(_children[parentId], parentId);
+            rebuilt[parentId] = true;
         }
+    }
 
-        // remove section id from connectivity and section lists
-        _children.erase(section_id);
-        _parent.erase(section_id);
-        _sections.erase(section_id);
+    // Detach the deleted sections, which may still be referenced by the caller
+    for (uint32_t id : deletedIds) {
+        const std::shared_ptr<Section> section = _sectionSlots[id];
+        section->morphology_ = nullptr;
+        section->id_ = 0xffffffff;
+        _sectionSlots[id] = nullptr;
+        _parent[id] = noParent;
+        std::vector<std::shared_ptr<Section>>().swap(_children[id]);
     }
+    _sectionsStale.store(true, std::memory_order_relaxed);
 }
 
 void Morphology::removeUnifurcations() {
@@ -246,77 +398,240 @@ void Morphology::removeUnifurcations() {
 void Morphology::removeUnifurcations(const morphio::readers::DebugInfo& debugInfo) {
     morphio::readers::ErrorMessages err(debugInfo._filename);
 
-    auto it = depth_begin();
-    while (it != depth_end()) {
-        std::shared_ptr<Section> section_ = *it;
-
-        // Incrementing iterator here before we potentially delete the section
-        ++it;
-        unsigned int sectionId = section_->id();
+    // Merging a section into its parent does not change the depth first order of the
+    // remaining sections, so it can be computed up front
+    const std::vector<std::shared_ptr<Section>> sections(depth_begin(), depth_end());
 
+    bool merged = false;
+    for (const std::shared_ptr<Section>& section_ : sections) {
         if (section_->isRoot()) {
             continue;
         }
 
-        unsigned int parentId = section_->parent()->id();
+        const uint32_t sectionId = section_->id();
+        const std::shared_ptr<Section>& parent = _sectionSlots[_parent[sectionId]];
+        const uint32_t parentId = parent->id();
 
         if (!ErrorMessages::isIgnored(Warning::WRONG_DUPLICATE) &&
-            !_checkDuplicatePoint(section_->parent(), section_)) {
-            printError(Warning::WRONG_DUPLICATE,
-                       err.WARNING_WRONG_DUPLICATE(section_, section_->parent()));
+            !_checkDuplicatePoint(parent, section_)) {
+            printError(Warning::WRONG_DUPLICATE, err.WARNING_WRONG_DUPLICATE(section_, parent));
         }
 
-        auto parent = section_->parent();
-        bool isUnifurcation = parent->children().size() == 1;
-
         // This "if" condition ensures that "unifurcations" (ie. successive
         // sections with only 1 child) get merged together into a bigger section
-        if (isUnifurcation) {
-            printError(Warning::ONLY_CHILD, err.WARNING_ONLY_CHILD(debugInfo, parentId, sectionId));
-            bool duplicate = _checkDuplicatePoint(section_->parent(), section_);
+        if (_children[parentId].size() != 1) {
+            continue;
+        }
 
-            addAnnotation(morphio::Property::Annotation(morphio::AnnotationType::SINGLE_CHILD,
-                                                        sectionId,
-                                                        section_->properties(),
-                                                        "",
-                                                        debugInfo.getLineNumber(parentId)));
+        printError(Warning::ONLY_CHILD, err.WARNING_ONLY_CHILD(debugInfo, parentId, sectionId));
+        const int offset = _checkDuplicatePoint(parent, section_) ? 1 : 0;
 
-            morphio::_appendVector(parent->points(), section_->points(), duplicate ? 1 : 0);
+        morphio::_appendVector(parent->points(), section_->points(), offset);
+        morphio::_appendVector(parent->diameters(), section_->diameters(), offset);
+        if (!parent->perimeters().empty()) {
+            morphio::_appendVector(parent->perimeters(), section_->perimeters(), offset);
+        }
 
-            morphio::_appendVector(parent->diameters(), section_->diameters(), duplicate ? 1 : 0);
+        // The section is detached below, so its points can be moved into the annotation
+        addAnnotation(morphio::Property::Annotation(morphio::AnnotationType::SINGLE_CHILD,
+                                                    sectionId,
+                                                    std::move(section_->point_properties_),
+                                                    "",
+                                                    debugInfo.getLineNumber(parentId)));
+
+        // The children of the section replace it as the only child of its parent
+        _children[parentId] = std::move(_children[sectionId]);
+        _children[sectionId].clear();
+        for (const auto& child : _children[parentId]) {
+            _parent[child->id()] = parentId;
+        }
 
-            if (!parent->perimeters().empty()) {
-                morphio::_appendVector(parent->perimeters(),
-                                       section_->perimeters(),
-                                       duplicate ? 1 : 0);
-            }
+        _parent[sectionId] = noParent;
+        _sectionSlots[sectionId] = nullptr;
+        section_->morphology_ = nullptr;
+        section_->id_ = 0xffffffff;
+        merged = true;
+    }
 
-            deleteSection(section_, false);
-        }
+    if (merged) {
+        _sectionsStale.store(true, std::memory_order_relaxed);
+    }
+}
+
+uint64_t Morphology::_nextKey() noexcept {
+    static std::atomic<uint64_t> counter{0};
+    return ++counter;
+}
+
+Property::Properties Morphology::buildReadOnly(size_t n_threads) const {
+    return _buildReadOnly(nullptr, n_threads);
+}
+
+Snapshot Morphology::buildSnapshot(const Snapshot& previous, size_t n_threads) const {
+    Snapshot snapshot;
+    snapshot._morphology.reset(new morphio::Morphology(
+        std::make_shared<Property::Properties>(_buildReadOnly(&previous, n_threads))));
+    snapshot._key = _key;
+
+    std::vector<size_t> rootStarts;
+    const std::vector<uint32_t> order = _depthFirstOrder(rootStarts);
+    snapshot._positions.assign(_sectionSlots.size(), noParent);
+    snapshot._versions.assign(_sectionSlots.size(), 0);
+    for (size_t i = 0; i < order.size(); ++i) {
+        snapshot._positions[order[i]] = static_cast<uint32_t>(i);
+        snapshot._versions[order[i]] = _sectionSlots[order[i]]->version_;
     }
+    return snapshot;
 }
 
-Property::Properties Morphology::buildReadOnly() const {
-    int sectionIdOnDisk = 0;
-    std::map<uint32_t, int32_t> newIds;
+Property::Properties Morphology::_buildReadOnly(const Snapshot* previous,
+                                                size_t n_threads) const {
     Property::Properties properties{};
 
     properties._cellLevel = *_cellProperties;
     properties._cellLevel._somaType = _soma->type();
     appendProperties(properties._somaLevel, _soma->point_properties_);
 
-    for (auto it = depth_begin(); it != depth_end(); ++it) {
-        const std::shared_ptr<Section>& section = *it;
-        unsigned int sectionId = section->id();
-        int parentOnDisk = (section->isRoot() ? -1 : newIds[section->parent()->id()]);
+    // The depth first order, in which the subtree of each root is contiguous, and the new ID
+    // of every section
+    std::vector<size_t> rootStarts;
+    const std::vector<uint32_t> order = _depthFirstOrder(rootStarts);
+    std::vector<int32_t> newIds(_sectionSlots.size(), -1);
+    for (size_t i = 0; i < order.size(); ++i) {
+        newIds[order[i]] = static_cast<int32_t>(i);
+    }
 
-        auto start = static_cast<int>(properties._pointLevel._points.size());
-        properties._sectionLevel._sections.push_back({start, parentOnDisk});
-        properties._sectionLevel._sectionTypes.push_back(section->type());
-        newIds[sectionId] = sectionIdOnDisk++;
-        appendProperties(properties._pointLevel, section->point_properties_);
+    // The previous snapshot of this morphology, if its diameters follow its points
+    const Property::Properties* snapshot = nullptr;
+    if (previous != nullptr && previous->_morphology != nullptr && previous->_key == _key) {
+        const auto& level = previous->_morphology->properties_->_pointLevel;
+        if (level._diameters.size() == level._points.size()) {
+            snapshot = previous->_morphology->properties_.get();
+        }
     }
 
+    // Where the point data of each section comes from, and at which section position: the
+    // previous snapshot if the section did not change since, the read-only properties it was
+    // copied from and not accessed since, or the section itself (null)
+    struct Origin {
+        const Property::Properties* properties;
+        uint32_t position;
+    };
+    const auto origin = [snapshot, previous](const Section& section) -> Origin {
+        const uint32_t id = section.id();
+        if (snapshot != nullptr && !section.exposed_ && id < previous->_positions.size() &&
+            previous->_positions[id] != noParent &&
+            previous->_versions[id] == section.version_) {
+            return {snapshot, previous->_positions[id]};
+        }
+        return {section.source_.get(), section.sourcePosition_};
+    };
+    const auto originStart = [](const Property::Properties& origin, uint32_t position) {
+        return position < origin._sectionLevel._sections.size()
+                   ? static_cast<size_t>(origin._sectionLevel._sections[position][0])
+                   : origin._pointLevel._points.size();
+    };
+
+    // Where the data of each section starts, so that the arrays are allocated at their final
+    // size and the sections filled independently. Sections without perimeters add none.
+    const size_t sectionCount = order.size();
+    std::vector<size_t> pointStarts(sectionCount + 1, 0);
+    std::vector<size_t> diameterStarts(sectionCount + 1, 0);
+    std::vector<size_t> perimeterStarts(sectionCount + 1, 0);
+    for (size_t i = 0; i < sectionCount; ++i) {
+        const Section& section = *_sectionSlots[order[i]];
+        if (section.source_) {
+            const size_t count = section.pointCount();
+            pointStarts[i + 1] = pointStarts[i] + count;
+            diameterStarts[i + 1] = diameterStarts[i] + count;
+            perimeterStarts[i + 1] = perimeterStarts[i] +
+                                     (section.source_->_pointLevel._perimeters.empty() ? 0
+                                                                                       : count);
+        } else {
+            const auto& level = section.point_properties_;
+            pointStarts[i + 1] = pointStarts[i] + level._points.size();
+            diameterStarts[i + 1] = diameterStarts[i] + level._diameters.size();
+            perimeterStarts[i + 1] = perimeterStarts[i] + level._perimeters.size();
+        }
+    }
+
+    auto& pointLevel = properties._pointLevel;
+    auto& sections = properties._sectionLevel._sections;
+    auto& sectionTypes = properties._sectionLevel._sectionTypes;
+    pointLevel._points.resize(pointStarts[sectionCount]);
+    pointLevel._diameters.resize(diameterStarts[sectionCount]);
+    pointLevel._perimeters.resize(perimeterStarts[sectionCount]);
+    sections.resize(sectionCount);
+    sectionTypes.resize(sectionCount);
+
+    detail::parallel_for(_rootSections.size(), n_threads, [&](size_t root) {
+        for (size_t i = rootStarts[root]; i < rootStarts[root + 1]; ++i) {
+            const uint32_t id = order[i];
+            const Section& section = *_sectionSlots[id];
+            const int32_t parentOnDisk = _hasSection(_parent[id]) ? newIds[_parent[id]] : -1;
+            sections[i] = {static_cast<int>(pointStarts[i]), parentOnDisk};
+            sectionTypes[i] = section.type();
+
+            // The perimeters are copied per section, as sections without perimeters add none
+            const auto perimeters = pointLevel._perimeters.begin() +
+                                    static_cast<std::ptrdiff_t>(perimeterStarts[i]);
+            if (!section.source_) {
+                std::copy(section.point_properties_._perimeters.begin(),
+                          section.point_properties_._perimeters.end(),
+                          perimeters);
+            } else if (!section.source_->_pointLevel._perimeters.empty()) {
+                const SectionRange range = section.sourceRange();
+                const auto& source = section.source_->_pointLevel._perimeters;
+                std::copy(source.begin() + static_cast<std::ptrdiff_t>(range.first),
+                          source.begin() + static_cast<std::ptrdiff_t>(range.second),
+                          perimeters);
+            }
+        }
+
+        // The points and diameters are copied by runs of sections that are consecutive in
+        // the properties they come from
+        for (size_t i = rootStarts[root]; i < rootStarts[root + 1];) {
+            const Section& section = *_sectionSlots[order[i]];
+            const Origin from = origin(section);
+            if (from.properties == nullptr) {
+                const auto& level = section.point_properties_;
+                std::copy(level._points.begin(),
+                          level._points.end(),
+                          pointLevel._points.begin() +
+                              static_cast<std::ptrdiff_t>(pointStarts[i]));
+                std::copy(level._diameters.begin(),
+                          level._diameters.end(),
+                          pointLevel._diameters.begin() +
+                              static_cast<std::ptrdiff_t>(diameterStarts[i]));
+                ++i;
+                continue;
+            }
+
+            const uint32_t first = from.position;
+            size_t next = i + 1;
+            while (next < rootStarts[root + 1]) {
+                const Origin other = origin(*_sectionSlots[order[next]]);
+                if (other.properties != from.properties ||
+                    other.position != first + static_cast<uint32_t>(next - i)) {
+                    break;
+                }
+                ++next;
+            }
+            const Property::PointLevel& fromLevel = from.properties->_pointLevel;
+            const auto begin = static_cast<std::ptrdiff_t>(originStart(*from.properties, first));
+            const auto end = static_cast<std::ptrdiff_t>(
+                originStart(*from.properties, first + static_cast<uint32_t>(next - i)));
+            std::copy(fromLevel._points.begin() + begin,
+                      fromLevel._points.begin() + end,
+                      pointLevel._points.begin() + static_cast<std::ptrdiff_t>(pointStarts[i]));
+            std::copy(fromLevel._diameters.begin() + begin,
+                      fromLevel._diameters.begin() + end,
+                      pointLevel._diameters.begin() +
+                          static_cast<std::ptrdiff_t>(diameterStarts[i]));
+            i = next;
+        }
+    });
+
     mitochondria()._buildMitochondria(properties);
     properties._endoplasmicReticulumLevel = endoplasmicReticulum().buildReadOnly();
     properties._dendriticSpineLevel = _dendriticSpineLevel;
@@ -324,6 +639,29 @@ Property::Properties Morphology::buildReadOnly() const {
     return properties;
 }
 
+std::vector<uint32_t> Morphology::_depthFirstOrder(std::vector<size_t>& rootStarts) const {
+    std::vector<uint32_t> order;
+    order.reserve(_sectionSlots.size());
+    rootStarts.clear();
+    rootStarts.reserve(_rootSections.size() + 1);
+    std::vector<uint32_t> stack;
+    for (const auto& root : _rootSections) {
+        rootStarts.push_back(order.size());
+        stack.push_back(root->id());
+        while (!stack.empty()) {
+            const uint32_t id = stack.back();
+            stack.pop_back();
+            order.push_back(id);
+            const auto& children = _children[id];
+            for (auto it = children.rbegin(); it != children.rend(); ++it) {
+                stack.push_back((*it)->id());
+            }
+        }
+    }
+    rootStarts.push_back(order.size());
+    return order;
+}
+
 depth_iterator Morphology::depth_begin() const {
     return depth_iterator(*this);
 }
@@ -340,7 +678,7 @@ breadth_iterator Morphology::breadth_end() const {
     return breadth_iterator();
 }
 
-void Morphology::applyModifiers(unsigned int modifierFlags) {
+void Morphology::applyModifiers(unsigned int modifierFlags, size_t n_threads) {
     if (modifierFlags & NO_DUPLICATES & TWO_POINTS_SECTIONS) {
         throw SectionBuilderError(
             _err.ERROR_UNCOMPATIBLE_FLAGS(NO_DUPLICATES, TWO_POINTS_SECTIONS));
@@ -351,11 +689,11 @@ void Morphology::applyModifiers(unsigned int modifierFlags) {
     }
 
     if (modifierFlags & NO_DUPLICATES) {
-        modifiers::no_duplicate_point(*this);
+        modifiers::no_duplicate_point(*this, n_threads);
     }
 
     if (modifierFlags & TWO_POINTS_SECTIONS) {
-        modifiers::two_points_sections(*this);
+        modifiers::two_points_sections(*this, n_threads);
     }
 
     if (modifierFlags & NRN_ORDER) {
@@ -373,11 +711,15 @@ std::unordered_map<int, std::vector<unsigned int>> Morphology::connectivity() {
                    std::back_inserter(connectivity[-1]),
                    [](const std::shared_ptr<Section>& section) { return section->id(); });
 
-    for (const auto& kv : _children) {
-        auto& nodeEdges = connectivity[static_cast<int>(kv.first)];
-        nodeEdges.reserve(kv.second.size());
-        std::transform(kv.second.begin(),
-                       kv.second.end(),
+    for (size_t id = 0; id < _children.size(); ++id) {
+        const auto& children = _children[id];
+        if (children.empty()) {
+            continue;
+        }
+        auto& nodeEdges = connectivity[static_cast<int>(id)];
+        nodeEdges.reserve(children.size());
+        std::transform(children.begin(),
+                       children.end(),
                        std::back_inserter(nodeEdges),
                        [](const std::shared_ptr<Section>& section) { return section->id(); });
     }
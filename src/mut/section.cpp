@@ -1,4 +1,8 @@
-#include <algorithm>  // any_of
+#include <algorithm>  // std::any_of, std::move
+#include <cstddef>    // std::ptrdiff_t
+#include <stdexcept>  // std::out_of_range
+#include <string>     // std::to_string
+#include <utility>    // std::move
 
 #include <morphio/errorMessages.h>
 #include <morphio/mut/morphology.h>
@@ -12,30 +16,100 @@ namespace morphio {
 namespace mut {
 using morphio::readers::ErrorMessages;
 
-static inline bool _emptySection(const std::shared_ptr<Section>& section) {
-    return section->points().empty();
-}
-
 Section::Section(Morphology* morphology,
                  unsigned int id,
                  SectionType type,
-                 const Property::PointLevel& pointProperties)
+                 Property::PointLevel pointProperties)
     : morphology_(morphology)
-    , point_properties_(pointProperties)
+    , point_properties_(std::move(pointProperties))
     , id_(id)
     , section_type_(type) {}
 
 Section::Section(Morphology* morphology, unsigned int id, const morphio::Section& section)
-    : Section(morphology,
-              id,
-              section.type(),
-              Property::PointLevel(section.properties_->_pointLevel, section.range_)) {}
+    : morphology_(morphology)
+    , id_(id)
+    , section_type_(section.type())
+    , source_(section.properties_)
+    , sourcePosition_(section.id()) {}
 
 Section::Section(Morphology* morphology, unsigned int id, const Section& section)
     : morphology_(morphology)
-    , point_properties_(section.point_properties_)
+    , point_properties_(section.source_ ? Property::PointLevel() : section.point_properties_)
     , id_(id)
-    , section_type_(section.section_type_) {}
+    , section_type_(section.section_type_)
+    , source_(section.source_)
+    , sourcePosition_(section.sourcePosition_) {}
+
+void Section::copySource() const {
+    point_properties_ = Property::PointLevel(source_->_pointLevel, sourceRange());
+}
+
+size_t Section::pointCount() const noexcept {
+    if (source_) {
+        const SectionRange range = sourceRange();
+        return range.second - range.first;
+    }
+    return point_properties_._points.size();
+}
+
+const Point& Section::pointAt(size_t i) const noexcept {
+    if (source_) {
+        return source_->_pointLevel._points[sourceRange().first + i];
+    }
+    return point_properties_._points[i];
+}
+
+SectionRange Section::sourceRange() const noexcept {
+    const auto& sections = source_->_sectionLevel._sections;
+    const auto begin = static_cast<size_t>(sections[sourcePosition_][0]);
+    const size_t end = sourcePosition_ + 1 < sections.size()
+                           ? static_cast<size_t>(sections[sourcePosition_ + 1][0])
+                           : source_->_pointLevel._points.size();
+    return {begin, end};
+}
+
+void Section::keepPoints(size_t begin, size_t end) {
+    ++version_;
+    if (source_) {
+        const SectionRange range = sourceRange();
+        point_properties_ = Property::PointLevel(source_->_pointLevel,
+                                                 {range.first + begin, range.first + end});
+        source_.reset();
+        return;
+    }
+
+    // The kept range is moved to the front in a single pass, and the tail dropped
+    const auto keep = [begin, end](auto& values) {
+        if (values.empty()) {
+            return;
+        }
+        std::move(values.begin() + static_cast<std::ptrdiff_t>(begin),
+                  values.begin() + static_cast<std::ptrdiff_t>(end),
+                  values.begin());
+        values.resize(end - begin);
+    };
+    keep(point_properties_._points);
+    keep(point_properties_._diameters);
+    keep(point_properties_._perimeters);
+}
+
+void Section::keepEnds() {
+    ++version_;
+    const Property::PointLevel& from = source_ ? source_->_pointLevel : point_properties_;
+    const SectionRange range = source_ ? sourceRange()
+                                       : SectionRange{0, point_properties_._points.size()};
+    const auto keep = [&range](auto& values, const auto& fromValues) {
+        if (fromValues.empty()) {
+            values.clear();
+            return;
+        }
+        values = {fromValues[range.first], fromValues[range.second - 1]};
+    };
+    keep(point_properties_._points, from._points);
+    keep(point_properties_._diameters, from._diameters);
+    keep(point_properties_._perimeters, from._perimeters);
+    source_.reset();
+}
 
 void Section::throwIfNoOwningMorphology() const {
     if (!morphology_) {
@@ -50,19 +124,19 @@ Morphology* Section::getOwningMorphologyOrThrow() const {
 
 const std::shared_ptr<Section>& Section::parent() const {
     const Morphology* morphology = getOwningMorphologyOrThrow();
-    return morphology->_sections.at(morphology->_parent.at(id()));
+    if (isRoot()) {
+        throw std::out_of_range("Section " + std::to_string(id()) + " has no parent");
+    }
+    return morphology->_sectionSlots[morphology->_parent[id()]];
 }
 
 bool Section::isRoot() const {
     const Morphology* morphology = getOwningMorphologyOrThrow();
-    const auto parentId = morphology->_parent.find(id());
-    if (parentId != morphology->_parent.end()) {
-        return morphology->_sections.find(parentId->second) == morphology->_sections.end();
-    }
-    return true;
+    return id() >= morphology->_parent.size() ||
+           !morphology->_hasSection(morphology->_parent[id()]);
 }
 
-bool Section::hasSameShape(const Section& other) const noexcept {
+bool Section::hasSameShape(const Section& other) const {
     return (other.type() == type() && other.diameters() == diameters() &&
             other.points() == points() && other.perimeters() == perimeters());
 }
@@ -80,12 +154,11 @@ bool Section::isHeterogeneous(bool downstream) const {
 const std::vector<std::shared_ptr<Section>>& Section::children() const {
     const Morphology* morphology = getOwningMorphologyOrThrow();
 
-    const auto it = morphology->_children.find(id());
-    if (it == morphology->_children.end()) {
+    if (id() >= morphology->_children.size()) {
         static std::vector<std::shared_ptr<Section>> empty;
         return empty;
     }
-    return it->second;
+    return morphology->_children[id()];
 }
 
 depth_iterator Section::depth_begin() const {
@@ -138,9 +211,9 @@ std::shared_ptr<Section> Section::appendSection(std::shared_ptr<Section> origina
         new Section(morphology, morphology->_counter, *original_section));
     unsigned int parentId = id();
     uint32_t childId = morphology->_register(ptr);
-    auto& _sections = morphology->_sections;
+    const auto& _sections = morphology->_sectionSlots;
 
-    bool emptySection = _emptySection(_sections[childId]);
+    bool emptySection = _sections[childId]->pointCount() == 0;
     if (emptySection) {
         printError(Warning::APPENDING_EMPTY_SECTION,
                    morphology->_err.WARNING_APPENDING_EMPTY_SECTION(_sections[childId]));
@@ -175,9 +248,9 @@ std::shared_ptr<Section> Section::appendSection(const morphio::Section& section,
     // const auto ptr = std::make_shared<Section>(morphology, morphology->_counter, section);
     unsigned int parentId = id();
     uint32_t childId = morphology->_register(ptr);
-    auto& _sections = morphology->_sections;
+    const auto& _sections = morphology->_sectionSlots;
 
-    bool emptySection = _emptySection(_sections[childId]);
+    bool emptySection = _sections[childId]->pointCount() == 0;
     if (emptySection) {
         printError(Warning::APPENDING_EMPTY_SECTION,
                    morphology->_err.WARNING_APPENDING_EMPTY_SECTION(_sections[childId]));
@@ -207,7 +280,7 @@ std::shared_ptr<Section> Section::appendSection(const Property::PointLevel& poin
     Morphology* morphology = getOwningMorphologyOrThrow();
     unsigned int parentId = id();
 
-    auto& _sections = morphology->_sections;
+    const auto& _sections = morphology->_sectionSlots;
     if (sectionType == SectionType::SECTION_UNDEFINED) {
         sectionType = type();
     }
@@ -221,7 +294,7 @@ std::shared_ptr<Section> Section::appendSection(const Property::PointLevel& poin
 
     uint32_t childId = morphology->_register(ptr);
 
-    bool emptySection = _emptySection(_sections[childId]);
+    bool emptySection = _sections[childId]->pointCount() == 0;
     if (emptySection) {
         printError(Warning::APPENDING_EMPTY_SECTION,
                    morphology->_err.WARNING_APPENDING_EMPTY_SECTION(_sections[childId]));
@@ -2,6 +2,7 @@
 #include <fstream>
 #include <iomanip>  // std::fixed, std::setw, std::setprecision
 
+#include <morphio/collection.h>
 #include <morphio/errorMessages.h>
 #include <morphio/mut/mitochondria.h>
 #include <morphio/mut/morphology.h>
@@ -13,6 +14,8 @@
 #include <highfive/H5File.hpp>
 #include <highfive/H5Object.hpp>
 
+#include "../readers/morphologyHDF5.h"  // global_hdf5_mutex
+
 namespace {
 
 /**
@@ -292,7 +295,7 @@ void write_dataset(HighFive::Group& file, const std::string& name, const T& raw)
     dpoints.write(raw);
 }
 
-static void mitochondriaH5(HighFive::File& h5_file, const Mitochondria& mitochondria) {
+static void mitochondriaH5(HighFive::Group& h5_group, const Mitochondria& mitochondria) {
     if (mitochondria.rootSections().empty()) {
         return;
     }
@@ -317,7 +320,7 @@ static void mitochondriaH5(HighFive::File& h5_file, const Mitochondria& mitochon
         structure.push_back({section[0], section[1]});
     }
 
-    HighFive::Group g_organelles = h5_file.createGroup("organelles");
+    HighFive::Group g_organelles = h5_group.createGroup("organelles");
     HighFive::Group g_mitochondria = g_organelles.createGroup("mitochondria");
 
     write_dataset(g_mitochondria, "points", points);
@@ -325,12 +328,13 @@ static void mitochondriaH5(HighFive::File& h5_file, const Mitochondria& mitochon
 }
 
 
-static void endoplasmicReticulumH5(HighFive::File& h5_file, const EndoplasmicReticulum& reticulum) {
+static void endoplasmicReticulumH5(HighFive::Group& h5_group,
+                                   const EndoplasmicReticulum& reticulum) {
     if (reticulum.sectionIndices().empty()) {
         return;
     }
 
-    HighFive::Group g_organelles = h5_file.createGroup("organelles");
+    HighFive::Group g_organelles = h5_group.createGroup("organelles");
     HighFive::Group g_reticulum = g_organelles.createGroup("endoplasmic_reticulum");
 
     write_dataset(g_reticulum, "section_index", reticulum.sectionIndices());
@@ -339,11 +343,11 @@ static void endoplasmicReticulumH5(HighFive::File& h5_file, const EndoplasmicRet
     write_dataset(g_reticulum, "surface_area", reticulum.surfaceAreas());
 }
 
-static void dendriticSpinePostSynapticDensityH5(HighFive::File& h5_file,
+static void dendriticSpinePostSynapticDensityH5(HighFive::Group& h5_group,
                                                 const Property::DendriticSpine::Level& l) {
     const auto& psd = l._post_synaptic_density;
 
-    HighFive::Group g_organelles = h5_file.createGroup("organelles");
+    HighFive::Group g_organelles = h5_group.createGroup("organelles");
     HighFive::Group g_postsynaptic_density = g_organelles.createGroup("postsynaptic_density");
 
     std::vector<morphio::Property::DendriticSpine::SectionId_t> sectionIds;
@@ -364,25 +368,35 @@ static void dendriticSpinePostSynapticDensityH5(HighFive::File& h5_file,
 }
 
 
-void h5(const Morphology& morpho, const std::string& filename) {
+/**
+   Return false, after warning, if there is nothing to write
+ **/
+static bool checkH5Writable(const Morphology& morpho) {
     const auto& soma = morpho.soma();
-    const auto& somaPoints = soma->points();
-    const auto numberOfSomaPoints = somaPoints.size();
 
-    if (numberOfSomaPoints < 1) {
+    if (soma->points().empty()) {
         if (morpho.rootSections().empty()) {
             printError(Warning::WRITE_EMPTY_MORPHOLOGY,
                        readers::ErrorMessages().WARNING_WRITE_EMPTY_MORPHOLOGY());
-            return;
+            return false;
         }
         printError(Warning::WRITE_NO_SOMA, readers::ErrorMessages().WARNING_WRITE_NO_SOMA());
     }
 
     checkSomaHasSameNumberPointsDiameters(*soma);
+    return true;
+}
 
-    HighFive::File h5_file(filename,
-                           HighFive::File::ReadWrite | HighFive::File::Create |
-                               HighFive::File::Truncate);
+/**
+   Write the datasets of a morphology below `h5_group`
+
+   The points are written first, so that the order of the morphologies in a container
+   is the order of their points on disk.
+ **/
+static void h5Group(HighFive::Group& h5_group, const Morphology& morpho) {
+    const auto& soma = morpho.soma();
+    const auto& somaPoints = soma->points();
+    const auto numberOfSomaPoints = somaPoints.size();
 
     int sectionIdOnDisk = 1;
     std::map<uint32_t, int32_t> newIds;
@@ -441,26 +455,128 @@ void h5(const Morphology& morpho, const std::string& filename) {
         offset += numberOfPoints;
     }
 
-    write_dataset(h5_file, "/points", raw_points);
-    write_dataset(h5_file, "/structure", raw_structure);
+    write_dataset(h5_group, "points", raw_points);
+    write_dataset(h5_group, "structure", raw_structure);
 
-    HighFive::Group g_metadata = h5_file.createGroup("metadata");
+    HighFive::Group g_metadata = h5_group.createGroup("metadata");
 
     write_attribute(g_metadata, "version", std::array<uint32_t, 2>{1, 3});
     write_attribute(g_metadata,
                     "cell_family",
                     std::vector<uint32_t>{static_cast<uint32_t>(morpho.cellFamily())});
-    write_attribute(h5_file, "comment", std::vector<std::string>{version_string()});
 
     if (hasPerimeterData_) {
-        write_dataset(h5_file, "/perimeters", raw_perimeters);
+        write_dataset(h5_group, "perimeters", raw_perimeters);
     }
 
-    mitochondriaH5(h5_file, morpho.mitochondria());
-    endoplasmicReticulumH5(h5_file, morpho.endoplasmicReticulum());
+    mitochondriaH5(h5_group, morpho.mitochondria());
+    endoplasmicReticulumH5(h5_group, morpho.endoplasmicReticulum());
     if (morpho.cellFamily() == SPINE) {
-        dendriticSpinePostSynapticDensityH5(h5_file, morpho._dendriticSpineLevel);
+        dendriticSpinePostSynapticDensityH5(h5_group, morpho._dendriticSpineLevel);
+    }
+}
+
+void h5(const Morphology& morpho, const std::string& filename) {
+    if (!checkH5Writable(morpho)) {
+        return;
     }
+
+    HighFive::File h5_file(filename,
+                           HighFive::File::ReadWrite | HighFive::File::Create |
+                               HighFive::File::Truncate);
+
+    HighFive::Group root = h5_file.getGroup("/");
+    h5Group(root, morpho);
+    write_attribute(h5_file, "comment", std::vector<std::string>{version_string()});
+}
+
+namespace {
+/**
+   File access property aligning every object to `alignment` bytes and gathering the
+   metadata in blocks, so that the raw data of consecutive morphologies stays contiguous
+ **/
+class ContainerAccessProperty
+{
+  public:
+    explicit ContainerAccessProperty(hsize_t alignment, hsize_t metadataBlockSize)
+        : _alignment(alignment)
+        , _metadataBlockSize(metadataBlockSize) {}
+
+    void apply(hid_t hid) const {
+        if (H5Pset_alignment(hid, 0, _alignment) < 0 ||
+            H5Pset_meta_block_size(hid, _metadataBlockSize) < 0) {
+            throw WriterError("Unable to set the container file access properties");
+        }
+    }
+
+  private:
+    hsize_t _alignment;
+    hsize_t _metadataBlockSize;
+};
+
+HighFive::File createContainer(const std::string& filename) {
+    constexpr hsize_t alignment = 8;
+    constexpr hsize_t metadataBlockSize = 1 << 20;
+
+    HighFive::FileAccessProps fapl;
+    fapl.add(ContainerAccessProperty(alignment, metadataBlockSize));
+
+    std::lock_guard<std::recursive_mutex> lock(readers::h5::global_hdf5_mutex());
+    return HighFive::File(filename,
+                          HighFive::File::ReadWrite | HighFive::File::Create |
+                              HighFive::File::Truncate,
+                          fapl);
+}
+}  // namespace
+
+ContainerWriter::ContainerWriter(const std::string& filename)
+    : _file(createContainer(filename)) {
+    std::lock_guard<std::recursive_mutex> lock(readers::h5::global_hdf5_mutex());
+    write_attribute(_file, "comment", std::vector<std::string>{version_string()});
+}
+
+void ContainerWriter::append(const std::string& name, const Morphology& morphology) {
+    if (!checkH5Writable(morphology)) {
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(readers::h5::global_hdf5_mutex());
+    HighFive::Group group = _file.createGroup(name);
+    h5Group(group, morphology);
+}
+
+void ContainerWriter::append(const Collection& collection,
+                             const std::vector<std::string>& names,
+                             const std::vector<size_t>& order) {
+    if (order.empty()) {
+        for (const auto& name : names) {
+            append(name, collection.load<Morphology>(name));
+        }
+        return;
+    }
+
+    if (order.size() != names.size()) {
+        throw WriterError("The access order has " + std::to_string(order.size()) +
+                          " elements, but there are " + std::to_string(names.size()) +
+                          " morphologies");
+    }
+
+    std::vector<bool> seen(names.size(), false);
+    for (size_t i : order) {
+        if (i >= names.size() || seen[i]) {
+            throw WriterError("The access order is not a permutation of the morphologies");
+        }
+        seen[i] = true;
+    }
+
+    for (size_t i : order) {
+        append(names[i], collection.load<Morphology>(names[i]));
+    }
+}
+
+void ContainerWriter::flush() {
+    std::lock_guard<std::recursive_mutex> lock(readers::h5::global_hdf5_mutex());
+    _file.flush();
 }
 
 }  // end namespace writer
@@ -50,6 +50,19 @@ PointLevel& PointLevel::operator=(const PointLevel& other) {
     return *this;
 }
 
+PointsSoA::PointsSoA(const std::vector<morphio::Point>& points,
+                     const std::vector<floatType>& diameters)
+    : _x(points.size())
+    , _y(points.size())
+    , _z(points.size())
+    , _diameters(diameters.begin(), diameters.end()) {
+    for (size_t i = 0; i < points.size(); ++i) {
+        _x[i] = points[i][0];
+        _y[i] = points[i][1];
+        _z[i] = points[i][2];
+    }
+}
+
 template <typename T>
 bool compare(const std::vector<T>& vec1,
              const std::vector<T>& vec2,
@@ -165,35 +178,254 @@ bool compare(const morphio::range<const morphio::Point>& vec1,
     return true;
 }
 
-template <typename T, typename U>
-bool compare(const std::map<T, U>& vec1,
-             const std::map<T, U>& vec2,
-             const std::string& name,
-             LogLevel logLevel) {
-    if (vec1 == vec2) {
+template <typename T>
+bool compare(const T& el1, const T& el2, const std::string& name, LogLevel logLevel) {
+    if (el1 == el2) {
         return true;
     }
+
     if (logLevel > LogLevel::ERROR) {
-        if (vec1.size() != vec2.size()) {
-            printError(Warning::UNDEFINED,
-                       "Error comparing " + name + ", size differs: " +
-                           std::to_string(vec1.size()) + " vs " + std::to_string(vec2.size()));
+        printError(Warning::UNDEFINED, name + " differs");
+    }
+    return false;
+}
+
+ChildrenTable::ChildrenTable(const std::vector<Section::Type>& sections)
+    : _offsets(sections.size() + 1, 0) {
+    const auto count = static_cast<int>(sections.size());
+
+    // Counting sort on the parent IDs: the children of every section end up sorted by ID
+    bool parentsFirst = true;
+    for (int i = 0; i < count; ++i) {
+        const int parent = sections[static_cast<size_t>(i)][1];
+        if (parent < -1 || parent >= count) {
+            throw RawDataError("Section parent ID (" + std::to_string(parent) +
+                               ") is out of bounds (number of sections = " +
+                               std::to_string(count) + ")");
+        }
+        if (parent == -1) {
+            continue;
         }
+        parentsFirst = parentsFirst && parent < i;
+        ++_offsets[static_cast<size_t>(parent) + 1];
+    }
+    for (size_t i = 1; i < _offsets.size(); ++i) {
+        _offsets[i] += _offsets[i - 1];
     }
 
-    return false;
+    _ids.resize(_offsets.back());
+    std::vector<uint32_t> next(_offsets.begin(), _offsets.end() - 1);
+    for (uint32_t i = 0; i < sections.size(); ++i) {
+        const int parent = sections[i][1];
+        if (parent == -1) {
+            _roots.push_back(i);
+        } else {
+            _ids[next[static_cast<size_t>(parent)]++] = i;
+        }
+    }
+
+    // When every parent comes before its children, all the sections lead to a root
+    if (!parentsFirst) {
+        checkTree();
+    }
 }
 
-template <typename T>
-bool compare(const T& el1, const T& el2, const std::string& name, LogLevel logLevel) {
-    if (el1 == el2) {
-        return true;
+void ChildrenTable::checkTree() const {
+    const size_t count = _offsets.empty() ? 0 : _offsets.size() - 1;
+    std::vector<bool> visited(count, false);
+    size_t visitedCount = 0;
+    std::vector<uint32_t> stack(_roots.begin(), _roots.end());
+    while (!stack.empty()) {
+        const uint32_t id = stack.back();
+        stack.pop_back();
+        if (visited[id]) {
+            throw RawDataError("Section " + std::to_string(id) +
+                               " is reached more than once from the root sections");
+        }
+        visited[id] = true;
+        ++visitedCount;
+        const auto ids = children(id);
+        stack.insert(stack.end(), ids.begin(), ids.end());
     }
 
-    if (logLevel > LogLevel::ERROR) {
-        printError(Warning::UNDEFINED, name + " differs");
+    if (visitedCount != count) {
+        const auto unreachable = std::find(visited.begin(), visited.end(), false);
+        throw RawDataError("Section " + std::to_string(unreachable - visited.begin()) +
+                           " is not reachable from the root sections");
     }
-    return false;
+}
+
+std::map<int, std::vector<unsigned int>> ChildrenTable::toMap() const {
+    std::map<int, std::vector<unsigned int>> result;
+    if (!_roots.empty()) {
+        result[-1] = _roots;
+    }
+    for (uint32_t i = 0; i + 1 < _offsets.size(); ++i) {
+        const auto ids = children(i);
+        if (!ids.empty()) {
+            result[static_cast<int>(i)].assign(ids.begin(), ids.end());
+        }
+    }
+    return result;
+}
+
+ChildrenTable ChildrenTable::fromMap(const std::map<int, std::vector<unsigned int>>& children) {
+    ChildrenTable table;
+    size_t count = 0;
+    for (const auto& entry : children) {
+        if (entry.first < -1) {
+            throw RawDataError("Section parent ID (" + std::to_string(entry.first) +
+                               ") is out of bounds");
+        }
+        count = std::max(count, static_cast<size_t>(entry.first + 1));
+        for (unsigned int child : entry.second) {
+            count = std::max(count, static_cast<size_t>(child) + 1);
+        }
+    }
+
+    table._offsets.assign(count + 1, 0);
+    for (const auto& entry : children) {
+        if (entry.first == -1) {
+            table._roots.assign(entry.second.begin(), entry.second.end());
+        } else {
+            table._offsets[static_cast<size_t>(entry.first) + 1] =
+                static_cast<uint32_t>(entry.second.size());
+        }
+    }
+    for (size_t i = 1; i < table._offsets.size(); ++i) {
+        table._offsets[i] += table._offsets[i - 1];
+    }
+
+    table._ids.resize(table._offsets.back());
+    for (const auto& entry : children) {
+        if (entry.first != -1) {
+            std::copy(entry.second.begin(),
+                      entry.second.end(),
+                      table._ids.begin() + table._offsets[static_cast<size_t>(entry.first)]);
+        }
+    }
+    table.checkTree();
+    return table;
+}
+
+bool ChildrenTable::operator==(const ChildrenTable& other) const {
+    return _offsets == other._offsets && _ids == other._ids && _roots == other._roots;
+}
+
+bool ChildrenTable::operator!=(const ChildrenTable& other) const {
+    return !(*this == other);
+}
+
+TraversalOrders::TraversalOrders(const ChildrenTable& children) {
+    const size_t count = children._offsets.empty() ? 0 : children._offsets.size() - 1;
+    _depthFirst.reserve(count);
+    _breadthFirst.reserve(count);
+    _depthFirstPosition.resize(count);
+    _subtreeSize.resize(count, 1);
+
+    std::vector<uint32_t> stack(children._roots.rbegin(), children._roots.rend());
+    while (!stack.empty()) {
+        const uint32_t id = stack.back();
+        stack.pop_back();
+        _depthFirstPosition[id] = static_cast<uint32_t>(_depthFirst.size());
+        _depthFirst.push_back(id);
+        const auto ids = children.children(id);
+        for (size_t i = ids.size(); i > 0; --i) {
+            stack.push_back(ids[i - 1]);
+        }
+    }
+
+    _isDepthFirstLayout = _depthFirst.size() == count;
+    for (size_t i = 0; _isDepthFirstLayout && i < count; ++i) {
+        if (_depthFirst[i] != i) {
+            _isDepthFirstLayout = false;
+            break;
+        }
+    }
+
+    // In reverse depth first order, the children are visited before their parent
+    for (auto it = _depthFirst.rbegin(); it != _depthFirst.rend(); ++it) {
+        for (uint32_t child : children.children(*it)) {
+            _subtreeSize[*it] += _subtreeSize[child];
+        }
+    }
+
+    _breadthFirst = children._roots;
+    for (size_t i = 0; i < _breadthFirst.size(); ++i) {
+        const auto ids = children.children(_breadthFirst[i]);
+        _breadthFirst.insert(_breadthFirst.end(), ids.begin(), ids.end());
+    }
+}
+
+void SectionLevel::setChildren(ChildrenTable children) {
+    _children = std::move(children);
+    _connectivity.reset();
+    _traversal.reset();
+}
+
+const std::map<int, std::vector<unsigned int>>& SectionLevel::connectivity() const {
+    return _connectivity.get([this]() { return _children.toMap(); });
+}
+
+const std::map<int, std::vector<unsigned int>>& MitochondriaSectionLevel::connectivity() const {
+    return _connectivity.get([this]() { return _children.toMap(); });
+}
+
+const TraversalOrders& SectionLevel::traversal() const {
+    return _traversal.get([this]() { return TraversalOrders(_children); });
+}
+
+const TraversalOrders& MitochondriaSectionLevel::traversal() const {
+    return _traversal.get([this]() { return TraversalOrders(_children); });
+}
+
+PathDistances::PathDistances(const std::vector<morphio::Point>& points,
+                             const std::vector<Section::Type>& sections,
+                             const TraversalOrders& traversal)
+    : _points(points.size())
+    , _sectionStarts(sections.size()) {
+    // Parents come before their children in depth first order, so the distance at the end
+    // of the parent is known when a section is reached
+    for (auto sectionId : traversal._depthFirst) {
+        const auto start = static_cast<size_t>(sections[sectionId][0]);
+        const size_t end = sectionId + 1 == sections.size()
+                               ? points.size()
+                               : static_cast<size_t>(sections[sectionId + 1][0]);
+        const int32_t parent = sections[sectionId][1];
+
+        floatType distance = 0;
+        if (parent >= 0) {
+            const auto parentId = static_cast<size_t>(parent);
+            const auto parentStart = static_cast<size_t>(sections[parentId][0]);
+            const size_t parentEnd = parentId + 1 == sections.size()
+                                         ? points.size()
+                                         : static_cast<size_t>(sections[parentId + 1][0]);
+            distance = parentEnd > parentStart ? _points[parentEnd - 1]
+                                               : _sectionStarts[parentId];
+        }
+
+        _sectionStarts[sectionId] = distance;
+        if (start == end) {
+            continue;
+        }
+        _points[start] = distance;
+        for (size_t i = start + 1; i < end; ++i) {
+            distance += euclidean_distance(points[i - 1], points[i]);
+            _points[i] = distance;
+        }
+    }
+}
+
+const PathDistances& Properties::pathDistances() const {
+    return _pathDistances.get([this]() {
+        return PathDistances(get<Point>(), get<Section>(), traversal<Section>());
+    });
+}
+
+const PointsSoA& Properties::pointsSoA() const {
+    return _pointsSoA.get([this]() {
+        return PointsSoA(_pointLevel._points, _pointLevel._diameters);
+    });
 }
 
 bool SectionLevel::diff(const SectionLevel& other, LogLevel logLevel) const {
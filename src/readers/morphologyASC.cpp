@@ -3,6 +3,7 @@
 #include <morphio/mut/morphology.h>
 #include <morphio/mut/section.h>
 
+#include "../modifiers.h"
 
 #include "NeurolucidaLexer.inc"
 
@@ -374,9 +375,8 @@ Property::Properties load(const std::string& path,
     NeurolucidaParser parser(path);
 
     morphio::mut::Morphology& nb_ = parser.parse(contents);
-    nb_.applyModifiers(options);
-
     Property::Properties properties = nb_.buildReadOnly();
+    modifiers::applyModifiers(properties, options, ErrorMessages(path));
     properties._cellLevel._cellFamily = NEURON;
     properties._cellLevel._version = {"asc", 1, 0};
     return properties;
@@ -19,6 +19,7 @@
  */
 
 #include <cassert>
+#include <utility>  // std::move
 
 #include "morphologyHDF5.h"
 
@@ -120,7 +121,7 @@ Property::Properties MorphologyHDF5::load() {
         }
     }
 
-    return _properties;
+    return std::move(_properties);
 }
 
 void MorphologyHDF5::_readMetadata(const std::string& source) {
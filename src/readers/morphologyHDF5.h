@@ -17,6 +17,8 @@ class MorphologyHDF5
   public:
     MorphologyHDF5(const HighFive::Group& group);
     virtual ~MorphologyHDF5() = default;
+
+    /** Read the morphology; the data is moved out, so this can only be called once */
     Property::Properties load();
 
   private:
@@ -13,6 +13,9 @@
 #include <morphio/mut/soma.h>
 #include <morphio/properties.h>
 
+#include "../modifiers.h"
+#include "scopedIgnoredWarning.h"
+
 namespace {
 bool _ignoreLine(const std::string& line) {
     std::size_t pos = line.find_first_not_of("\n\r\t ");
@@ -262,8 +265,8 @@ class SWCBuilder
         }
     }
 
-    SomaType somaType() {
-        switch (morph.soma()->points().size()) {
+    SomaType somaType(size_t somaPointCount) {
+        switch (somaPointCount) {
         case 0: {
             return SOMA_UNDEFINED;
         }
@@ -318,8 +321,7 @@ class SWCBuilder
 
         // The process might occasionally creates empty section before
         // filling them so the warning is ignored
-        bool originalIsIgnored = err.isIgnored(morphio::Warning::APPENDING_EMPTY_SECTION);
-        set_ignored_warning(morphio::Warning::APPENDING_EMPTY_SECTION, true);
+        const ScopedIgnoredWarning ignoreEmptySections(morphio::Warning::APPENDING_EMPTY_SECTION);
 
         std::vector<unsigned int> depthFirstSamples;
         _pushChildren(depthFirstSamples, -1);
@@ -349,12 +351,9 @@ class SWCBuilder
             printError(morphio::WRONG_ROOT_POINT, err.WARNING_WRONG_ROOT_POINT(neurite_wrong_root));
         }
 
-        morph.applyModifiers(options);
-
         Property::Properties properties = morph.buildReadOnly();
-        properties._cellLevel._somaType = somaType();
-
-        set_ignored_warning(morphio::Warning::APPENDING_EMPTY_SECTION, originalIsIgnored);
+        modifiers::applyModifiers(properties, options, err);
+        properties._cellLevel._somaType = somaType(properties._somaLevel._points.size());
 
         return properties;
     }
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <morphio/enums.h>  // Warning
+
+namespace morphio {
+namespace readers {
+
+/**
+   Ignore a warning on the calling thread only, for the lifetime of the object.
+
+   Unlike set_ignored_warning, this does not affect morphologies loaded
+   concurrently by other threads.
+ **/
+class ScopedIgnoredWarning
+{
+  public:
+    explicit ScopedIgnoredWarning(Warning warning);
+    ~ScopedIgnoredWarning();
+
+    ScopedIgnoredWarning(const ScopedIgnoredWarning&) = delete;
+    ScopedIgnoredWarning& operator=(const ScopedIgnoredWarning&) = delete;
+
+  private:
+    Warning _warning;
+    bool _inserted;
+};
+
+}  // namespace readers
+}  // namespace morphio
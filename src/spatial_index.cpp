@@ -0,0 +1,317 @@
+#include <algorithm>  // std::sort
+#include <cmath>  // std::sqrt
+#include <limits>
+#include <string>  // std::to_string
+
+#include <morphio/exceptions.h>
+#include <morphio/morphology.h>
+#include <morphio/spatial_index.h>
+
+#include "bounding_volume_hierarchy.h"
+#include "thread_pool.h"
+
+namespace morphio {
+namespace {
+
+/** Leaves hold at most this many segments */
+constexpr uint32_t kLeafSize = 4;
+
+floatType squaredDistanceToSegment(const Point& point, const Point& start, const Point& end) {
+    floatType direction[3];
+    floatType offset[3];
+    floatType squaredLength = 0;
+    floatType projection = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        direction[i] = end[i] - start[i];
+        offset[i] = point[i] - start[i];
+        squaredLength += direction[i] * direction[i];
+        projection += direction[i] * offset[i];
+    }
+    const floatType t = squaredLength > 0 ? std::min(std::max(projection / squaredLength,
+                                                              floatType{0}),
+                                                     floatType{1})
+                                          : floatType{0};
+    floatType result = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        const floatType d = offset[i] - t * direction[i];
+        result += d * d;
+    }
+    return result;
+}
+
+/** Return the squared distance between the line segments [p0, p1] and [q0, q1] */
+floatType squaredDistanceBetweenSegments(const Point& p0,
+                                         const Point& p1,
+                                         const Point& q0,
+                                         const Point& q1) {
+    floatType d0[3];
+    floatType d1[3];
+    floatType r[3];
+    for (size_t i = 0; i < 3; ++i) {
+        d0[i] = p1[i] - p0[i];
+        d1[i] = q1[i] - q0[i];
+        r[i] = p0[i] - q0[i];
+    }
+    const auto dot = [](const floatType* u, const floatType* v) {
+        return u[0] * v[0] + u[1] * v[1] + u[2] * v[2];
+    };
+    const auto clamp = [](floatType value) {
+        return std::min(std::max(value, floatType{0}), floatType{1});
+    };
+    const floatType a = dot(d0, d0);
+    const floatType e = dot(d1, d1);
+    const floatType f = dot(d1, r);
+
+    // Parameters of the closest points, along [p0, p1] and [q0, q1]
+    floatType s = 0;
+    floatType t = 0;
+    if (a <= 0 && e <= 0) {
+        // Both segments are points
+    } else if (a <= 0) {
+        t = clamp(f / e);
+    } else {
+        const floatType c = dot(d0, r);
+        if (e <= 0) {
+            s = clamp(-c / a);
+        } else {
+            const floatType b = dot(d0, d1);
+            const floatType denominator = a * e - b * b;
+            s = denominator > 0 ? clamp((b * f - c * e) / denominator) : floatType{0};
+            t = (b * s + f) / e;
+            if (t < 0) {
+                t = 0;
+                s = clamp(-c / a);
+            } else if (t > 1) {
+                t = 1;
+                s = clamp((b - c) / a);
+            }
+        }
+    }
+
+    floatType result = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        const floatType d = r[i] + s * d0[i] - t * d1[i];
+        result += d * d;
+    }
+    return result;
+}
+
+}  // namespace
+
+SegmentIndex::SegmentIndex(const Morphology& morphology, size_t n_threads)
+    : _properties(morphology.properties_) {
+    const auto& points = _properties->get<Property::Point>();
+    const auto& sections = _properties->get<Property::Section>();
+
+    std::vector<Item> items;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        const auto start = static_cast<uint32_t>(sections[i][0]);
+        const auto end = static_cast<uint32_t>(
+            i + 1 == sections.size() ? points.size() : static_cast<size_t>(sections[i + 1][0]));
+        for (uint32_t p = start; p + 1 < end; ++p) {
+            items.push_back({p, {static_cast<uint32_t>(i), p - start}});
+        }
+    }
+
+    std::vector<Point> mins(items.size());
+    std::vector<Point> maxs(items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        Point start;
+        Point end;
+        floatType radius;
+        capsule(items[i], start, end, radius);
+        for (size_t axis = 0; axis < 3; ++axis) {
+            mins[i][axis] = std::min(start[axis], end[axis]) - radius;
+            maxs[i][axis] = std::max(start[axis], end[axis]) + radius;
+        }
+    }
+
+    std::vector<uint32_t> order;
+    detail::HierarchyBuilder(mins, maxs, kLeafSize).build(n_threads, _nodes, order);
+
+    _items.reserve(items.size());
+    for (auto i : order) {
+        _items.push_back(items[i]);
+    }
+}
+
+std::array<Point, 2> SegmentIndex::bounds() const {
+    if (_nodes.empty()) {
+        return {};
+    }
+    return {_nodes[0].min, _nodes[0].max};
+}
+
+void SegmentIndex::capsule(const Item& item,
+                           Point& start,
+                           Point& end,
+                           floatType& radius) const noexcept {
+    const auto& points = _properties->get<Property::Point>();
+    const auto& diameters = _properties->get<Property::Diameter>();
+    start = points[item.point];
+    end = points[item.point + 1];
+    radius = std::max(diameters[item.point], diameters[item.point + 1]) / 2;
+}
+
+std::vector<SegmentId> SegmentIndex::sphereQuery(const Point& center, floatType radius) const {
+    std::vector<SegmentId> result;
+    const floatType squaredRadius = radius * radius;
+    detail::visitHierarchy(
+        _nodes,
+        [&](const detail::BVHNode& node) {
+            return detail::squaredDistanceToBox(center, node.min, node.max) <= squaredRadius;
+        },
+        [&](uint32_t i) {
+            const Item& item = _items[i];
+            Point start;
+            Point end;
+            floatType capsuleRadius;
+            capsule(item, start, end, capsuleRadius);
+            const floatType reach = radius + capsuleRadius;
+            if (squaredDistanceToSegment(center, start, end) <= reach * reach) {
+                result.push_back(item.id);
+            }
+        });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<std::vector<SegmentId>> SegmentIndex::sphereQuery(const Points& centers,
+                                                              const std::vector<floatType>& radii,
+                                                              size_t n_threads) const {
+    if (centers.size() != radii.size()) {
+        throw MorphioError("SegmentIndex::sphereQuery: got " + std::to_string(centers.size()) +
+                           " centers but " + std::to_string(radii.size()) + " radii");
+    }
+    std::vector<std::vector<SegmentId>> result(centers.size());
+    detail::parallel_for(centers.size(), n_threads, [&](size_t i) {
+        result[i] = sphereQuery(centers[i], radii[i]);
+    });
+    return result;
+}
+
+std::vector<SegmentId> SegmentIndex::boxQuery(const Point& min, const Point& max) const {
+    std::vector<SegmentId> result;
+    detail::visitHierarchy(
+        _nodes,
+        [&](const detail::BVHNode& node) {
+            return detail::boxesIntersect(node.min, node.max, min, max);
+        },
+        [&](uint32_t i) {
+            Point start;
+            Point end;
+            floatType radius;
+            capsule(_items[i], start, end, radius);
+            Point itemMin;
+            Point itemMax;
+            for (size_t axis = 0; axis < 3; ++axis) {
+                itemMin[axis] = std::min(start[axis], end[axis]) - radius;
+                itemMax[axis] = std::max(start[axis], end[axis]) + radius;
+            }
+            if (detail::boxesIntersect(itemMin, itemMax, min, max)) {
+                result.push_back(_items[i].id);
+            }
+        });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<std::vector<SegmentId>> SegmentIndex::boxQuery(const Points& mins,
+                                                           const Points& maxs,
+                                                           size_t n_threads) const {
+    if (mins.size() != maxs.size()) {
+        throw MorphioError("SegmentIndex::boxQuery: got " + std::to_string(mins.size()) +
+                           " lower corners but " + std::to_string(maxs.size()) +
+                           " upper corners");
+    }
+    std::vector<std::vector<SegmentId>> result(mins.size());
+    detail::parallel_for(mins.size(), n_threads, [&](size_t i) {
+        result[i] = boxQuery(mins[i], maxs[i]);
+    });
+    return result;
+}
+
+std::vector<SegmentId> SegmentIndex::capsuleQuery(const Point& start,
+                                                  const Point& end,
+                                                  floatType radius) const {
+    Point min;
+    Point max;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        min[axis] = std::min(start[axis], end[axis]) - radius;
+        max[axis] = std::max(start[axis], end[axis]) + radius;
+    }
+
+    std::vector<SegmentId> result;
+    detail::visitHierarchy(
+        _nodes,
+        [&](const detail::BVHNode& node) {
+            return detail::boxesIntersect(node.min, node.max, min, max);
+        },
+        [&](uint32_t i) {
+            Point itemStart;
+            Point itemEnd;
+            floatType itemRadius;
+            capsule(_items[i], itemStart, itemEnd, itemRadius);
+            const floatType reach = radius + itemRadius;
+            if (squaredDistanceBetweenSegments(start, end, itemStart, itemEnd) <=
+                reach * reach) {
+                result.push_back(_items[i].id);
+            }
+        });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+NearestSegment SegmentIndex::nearest(const Point& point) const {
+    if (_nodes.empty()) {
+        throw MorphioError("SegmentIndex::nearest: the index is empty");
+    }
+
+    NearestSegment best{{0, 0}, std::numeric_limits<floatType>::max()};
+    std::vector<uint32_t> stack{0};
+    while (!stack.empty()) {
+        const detail::BVHNode& node = _nodes[stack.back()];
+        stack.pop_back();
+        if (std::sqrt(detail::squaredDistanceToBox(point, node.min, node.max)) >= best.distance) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                Point start;
+                Point end;
+                floatType radius;
+                capsule(_items[i], start, end, radius);
+                const floatType distance = std::max(
+                    std::sqrt(squaredDistanceToSegment(point, start, end)) - radius,
+                    floatType{0});
+                if (distance < best.distance ||
+                    (distance == best.distance && _items[i].id < best.segment)) {
+                    best = {_items[i].id, distance};
+                }
+            }
+        } else {
+            // Visit the nearer child first, so that the farther one is more likely pruned
+            const detail::BVHNode& left = _nodes[node.left];
+            const detail::BVHNode& right = _nodes[node.right];
+            if (detail::squaredDistanceToBox(point, left.min, left.max) <
+                detail::squaredDistanceToBox(point, right.min, right.max)) {
+                stack.push_back(node.right);
+                stack.push_back(node.left);
+            } else {
+                stack.push_back(node.left);
+                stack.push_back(node.right);
+            }
+        }
+    }
+    return best;
+}
+
+std::vector<NearestSegment> SegmentIndex::nearest(const Points& points, size_t n_threads) const {
+    std::vector<NearestSegment> result(points.size());
+    detail::parallel_for(points.size(), n_threads, [&](size_t i) {
+        result[i] = nearest(points[i]);
+    });
+    return result;
+}
+
+}  // namespace morphio
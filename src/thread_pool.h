@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>  // std::max, std::min
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>  // std::exception_ptr
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace morphio {
+namespace detail {
+
+/** Return the number of threads to use when the caller did not ask for a specific number */
+inline size_t defaultThreadCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/**
+ * Call `f(i)` for every `i` in [0, n) using `n_threads` threads, 0 meaning
+ * `defaultThreadCount()`.
+ *
+ * The calling thread takes part in the work. Indices are claimed one at a time, so
+ * that uneven work items are balanced. If a call throws, the remaining indices are
+ * skipped and the first exception is rethrown once all threads are done.
+ */
+template <typename F>
+void parallel_for(size_t n, size_t n_threads, const F& f) {
+    if (n_threads == 0) {
+        n_threads = defaultThreadCount();
+    }
+    n_threads = std::min(n_threads, n);
+
+    if (n_threads <= 1) {
+        for (size_t i = 0; i < n; ++i) {
+            f(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::mutex error_mutex;
+    std::exception_ptr error;
+
+    auto work = [&]() {
+        for (size_t i = next++; i < n; i = next++) {
+            try {
+                f(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next = n;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads - 1);
+    for (size_t t = 1; t < n_threads; ++t) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * A fixed set of worker threads executing tasks in submission order.
+ *
+ * Tasks must not throw; they are responsible for reporting their errors, e.g.
+ * through a std::promise. Destroying the pool runs the tasks still queued and
+ * joins the workers.
+ */
+class ThreadPool
+{
+  public:
+    explicit ThreadPool(size_t n_threads) {
+        n_threads = std::max<size_t>(1, n_threads);
+        _workers.reserve(n_threads);
+        for (size_t i = 0; i < n_threads; ++i) {
+            _workers.emplace_back([this]() { work(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _condition.notify_all();
+        for (auto& worker : _workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const noexcept {
+        return _workers.size();
+    }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push_back(std::move(task));
+        }
+        _condition.notify_one();
+    }
+
+  private:
+    void work() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+                if (_tasks.empty()) {
+                    return;
+                }
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<std::function<void()>> _tasks;
+    bool _stopping = false;
+    std::vector<std::thread> _workers;
+};
+
+}  // namespace detail
+}  // namespace morphio
@@ -31,8 +31,8 @@ def test_mut_immut_have_same_methods():
 
     only_in_immut = {'section_types', 'diameters', 'perimeters', 'points', 'n_points', 'section_offsets',
                      'as_mutable'}
-    only_in_mut = {'remove_unifurcations', 'write', 'append_root_section', 'delete_section', 'build_read_only',
-                   'as_immutable'}
+    only_in_mut = {'remove_unifurcations', 'write', 'append_root_section', 'append_sections',
+                   'delete_section', 'delete_sections', 'build_read_only', 'as_immutable'}
     assert (methods(morphio.Morphology) - only_in_immut ==
                  methods(morphio.mut.Morphology) - only_in_mut)
 
@@ -75,3 +75,38 @@ def test_container_unordered(collection_path):
             sorted(loop_indices),
             np.arange(len(morphology_names))
         )
+
+
+@pytest.mark.parametrize("collection_path", COLLECTION_PATHS)
+def test_load_many(collection_path):
+    with morphio.Collection(collection_path) as collection:
+        morphology_names = available_morphologies()
+
+        morphologies = collection.load_many(morphology_names, n_threads=2)
+        assert len(morphologies) == len(morphology_names)
+        for morph_name, morph in zip(morphology_names, morphologies):
+            expected = collection.load(morph_name)
+            np.testing.assert_array_equal(morph.points, expected.points)
+            np.testing.assert_array_equal(morph.section_offsets, expected.section_offsets)
+
+
+@pytest.mark.parametrize("collection_path", COLLECTION_PATHS)
+def test_load_batch(collection_path):
+    with morphio.Collection(collection_path) as collection:
+        morphology_names = available_morphologies()
+
+        batch = collection.load_batch(morphology_names)
+        assert len(batch) == len(morphology_names)
+        assert batch.points.shape == (batch.cell_point_offsets[-1], 3)
+        assert len(batch.section_offsets) == len(batch.section_types) + 1
+
+        for i, morph_name in enumerate(morphology_names):
+            expected = collection.load(morph_name)
+            points = slice(batch.cell_point_offsets[i], batch.cell_point_offsets[i + 1])
+            sections = slice(batch.cell_section_offsets[i], batch.cell_section_offsets[i + 1])
+            np.testing.assert_array_equal(batch.points[points], expected.points)
+            np.testing.assert_array_equal(batch.diameters[points], expected.diameters)
+            np.testing.assert_array_equal(batch.section_types[sections], expected.section_types)
+            np.testing.assert_array_equal(
+                batch.section_offsets[sections] - batch.cell_point_offsets[i],
+                expected.section_offsets[:-1])
@@ -241,6 +241,13 @@ def test_build_read_only():
     assert_array_equal(same_child.perimeters,
                        [20, 30])
 
+    section_level = m.build_read_only().section_level
+    section_level.children = {-1: [0], 0: [1, 2]}
+    assert section_level.children == {-1: [0], 0: [1, 2]}
+    # The getter returns a copy
+    section_level.children[0].append(3)
+    assert section_level.children == {-1: [0], 0: [1, 2]}
+
 
 def test_mutable_immutable_equivalence():
     morpho = ImmutableMorphology(Path(DATA_DIR, "simple.swc"))
@@ -0,0 +1,90 @@
+#include <catch2/catch.hpp>
+
+#include <morphio/morphology.h>
+#include <morphio/mut/morphology.h>
+#include <morphio/mut/writers.h>
+
+#include <atomic>
+#include <cstdlib>  // std::malloc, std::free
+#include <filesystem>
+#include <new>  // std::bad_alloc
+namespace fs = std::filesystem;
+
+// Count the allocations of a given size made by this test executable, the library included
+namespace {
+std::atomic<size_t> watchedSize{0};
+std::atomic<size_t> watchedCount{0};
+
+/** Return how many arrays of `bytes` bytes are allocated while calling `f` */
+template <typename F>
+size_t countAllocations(size_t bytes, const F& f) {
+    watchedCount = 0;
+    watchedSize = bytes;
+    f();
+    watchedSize = 0;
+    return watchedCount;
+}
+
+/**
+ * Return how many times the points array of the morphology at `path` is allocated at full
+ * size when loading it: 1 means that the data the reader produced is never copied.
+ */
+size_t countPointArrays(const std::string& path, unsigned int options = morphio::NO_MODIFIER) {
+    const auto bytes = morphio::Morphology(path, options).points().size() * sizeof(morphio::Point);
+    return countAllocations(bytes, [&]() { morphio::Morphology morphology(path, options); });
+}
+}  // namespace
+
+void* operator new(std::size_t size) {
+    if (size != 0 && size == watchedSize.load(std::memory_order_relaxed)) {
+        ++watchedCount;
+    }
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+    std::free(ptr);
+}
+
+TEST_CASE("LoadCopies", "[allocations]") {
+    auto tmpDirectory = fs::temp_directory_path() / "test_allocations.cpp";
+    fs::create_directories(tmpDirectory);
+    const std::string swcPath = "data/nrn_ordering.swc";
+    const std::string ascPath = tmpDirectory / "nrn_ordering.asc";
+    const std::string h5Path = tmpDirectory / "nrn_ordering.h5";
+    {
+        const morphio::mut::Morphology morphology(swcPath);
+        morphio::mut::writer::asc(morphology, ascPath);
+        morphio::mut::writer::h5(morphology, h5Path);
+    }
+
+    // The readers of SWC and ASC build a mut::Morphology, whose read-only version is moved
+    // into the morphio::Morphology
+    REQUIRE(countPointArrays(swcPath) == 1);
+    REQUIRE(countPointArrays(ascPath) == 1);
+
+    // The H5 reader reads the points straight into the Properties
+    REQUIRE(countPointArrays(h5Path) == 1);
+
+    // The modifiers of H5 morphologies are applied on the Properties read: the soma and the
+    // trimmed sections are modified in place
+    REQUIRE(countPointArrays(h5Path, morphio::Option::SOMA_SPHERE) == 1);
+
+    // Every reader applies NO_DUPLICATES and NRN_ORDER on the Properties read:
+    // - NO_DUPLICATES compacts the points in the array read, so that no array of the
+    //   final size is ever allocated
+    // - NRN_ORDER lays out the points in a new array, of the final size
+    for (const auto& path : {swcPath, ascPath, h5Path}) {
+        REQUIRE(countPointArrays(path, morphio::Option::NO_DUPLICATES) == 0);
+        REQUIRE(countPointArrays(path, morphio::Option::NRN_ORDER) == 2);
+    }
+
+    fs::remove_all(tmpDirectory);
+}
@@ -3,6 +3,7 @@
 #include <morphio/collection.h>
 #include <morphio/morphology.h>
 #include <morphio/mut/morphology.h>
+#include <morphio/mut/writers.h>
 
 #include <algorithm>
 #include <filesystem>
@@ -213,3 +214,155 @@ TEST_CASE("LoadUnordered::Iterator", "[collection]") {
     REQUIRE((*begin).first == k_begin);
     REQUIRE((*++it).first != k_begin);
 }
+
+TEST_CASE("Collection::load_batch", "[collection]") {
+    auto collection = morphio::Collection("data", {".swc"});
+    auto morphology_names = std::vector<std::string>{"simple", "complexe", "three_point_soma"};
+
+    auto batch = collection.load_batch(morphology_names);
+    REQUIRE(batch.size() == morphology_names.size());
+    REQUIRE(batch.cellSectionOffsets().size() == morphology_names.size() + 1);
+    REQUIRE(batch.sectionOffsets().size() == batch.sectionTypes().size() + 1);
+    REQUIRE(batch.sectionOffsets().back() == batch.points().size());
+    REQUIRE(batch.cellPointOffsets().back() == batch.points().size());
+    REQUIRE(batch.cellSomaPointOffsets().back() == batch.somaPoints().size());
+
+    for (size_t i = 0; i < morphology_names.size(); ++i) {
+        auto morph = collection.load<morphio::Morphology>(morphology_names[i]);
+        auto firstSection = batch.cellSectionOffsets()[i];
+        auto firstPoint = batch.cellPointOffsets()[i];
+
+        REQUIRE(batch.cellSectionOffsets()[i + 1] - firstSection == morph.sections().size());
+        REQUIRE(batch.cellPointOffsets()[i + 1] - firstPoint == morph.points().size());
+        REQUIRE(batch.somaTypes()[i] == morph.somaType());
+        REQUIRE(std::equal(morph.points().begin(),
+                           morph.points().end(),
+                           batch.points().begin() + static_cast<std::ptrdiff_t>(firstPoint)));
+        REQUIRE(std::equal(morph.sectionTypes().begin(),
+                           morph.sectionTypes().end(),
+                           batch.sectionTypes().begin() +
+                               static_cast<std::ptrdiff_t>(firstSection)));
+
+        for (const auto& section : morph.sections()) {
+            auto s = firstSection + section.id();
+            REQUIRE(batch.sectionOffsets()[s] - firstPoint == morph.sectionOffsets()[section.id()]);
+            REQUIRE(batch.sectionParents()[s] ==
+                    (section.isRoot() ? -1 : static_cast<int32_t>(section.parent().id())));
+        }
+    }
+}
+
+TEST_CASE("ContainerWriter", "[collection]") {
+    auto tmpDirectory = fs::temp_directory_path() / "test_collection.cpp";
+    fs::create_directories(tmpDirectory);
+    auto container_path = (tmpDirectory / "container.h5").string();
+
+    auto collection_dir = std::string("data/h5/v1");
+    auto morphology_names = std::vector<std::string>{
+        "simple", "glia", "mitochondria", "endoplasmic-reticulum", "simple-dendritric-spine"};
+    auto access_order = std::vector<size_t>{3, 1, 4, 0, 2};
+
+    {
+        auto writer = morphio::mut::writer::ContainerWriter(container_path);
+        writer.append(morphio::Collection(collection_dir), morphology_names, access_order);
+        CHECK_THROWS_AS(writer.append(morphio::Collection(collection_dir),
+                                      morphology_names,
+                                      std::vector<size_t>{0, 0, 1, 2, 3}),
+                        morphio::WriterError);
+    }
+
+    auto container = morphio::Collection(container_path);
+    REQUIRE(container.argsort(morphology_names) == access_order);
+
+    for (const auto& morph_name : morphology_names) {
+        auto reference_path = fs::path(collection_dir) / (morph_name + ".h5");
+        check_collection_vs_single_file<morphio::Morphology>(container,
+                                                             morph_name,
+                                                             reference_path.string());
+    }
+
+    container.close();
+    fs::remove_all(tmpDirectory);
+}
+
+TEST_CASE("Collection::load_async", "[collection]") {
+    auto collection = morphio::Collection("data", {".swc"});
+    auto morphology_names = std::vector<std::string>{
+        "simple", "complexe", "three_point_soma", "soma_cylinders", "simple"};
+
+    SECTION("immutable") {
+        collection.set_async_threads(3);
+        std::vector<std::future<morphio::Morphology>> futures;
+        for (const auto& morph_name : morphology_names) {
+            futures.push_back(collection.load_async<morphio::Morphology>(morph_name));
+        }
+
+        for (size_t i = 0; i < morphology_names.size(); ++i) {
+            auto expected = collection.load<morphio::Morphology>(morphology_names[i]);
+            auto actual = futures[i].get();
+            REQUIRE(actual.points() == expected.points());
+            REQUIRE(actual.sectionOffsets() == expected.sectionOffsets());
+        }
+    }
+
+    SECTION("mutable") {
+        auto future = collection.load_async<morphio::mut::Morphology>(
+            "simple", morphio::Option::TWO_POINTS_SECTIONS);
+        REQUIRE(future.get().rootSections().size() == 2);
+    }
+
+    SECTION("errors") {
+        auto future = collection.load_async<morphio::Morphology>("not-there");
+        CHECK_THROWS_AS(future.get(), morphio::MorphioError);
+    }
+
+    SECTION("serialized loads") {
+        // A single drain serves the requests of a container, whatever the number of threads
+        auto container = morphio::Collection("data/h5/v1/merged.h5");
+        container.set_async_threads(4);
+        auto container_names = std::vector<std::string>{
+            "simple", "glia", "endoplasmic-reticulum", "simple-dendritric-spine"};
+        std::vector<std::future<morphio::Morphology>> futures;
+        for (size_t repeat = 0; repeat < 8; ++repeat) {
+            for (const auto& morph_name : container_names) {
+                futures.push_back(container.load_async<morphio::Morphology>(morph_name));
+            }
+        }
+
+        for (size_t i = 0; i < futures.size(); ++i) {
+            auto expected = container.load<morphio::Morphology>(
+                container_names[i % container_names.size()]);
+            REQUIRE(futures[i].get().points() == expected.points());
+        }
+    }
+
+    SECTION("outlives the collection") {
+        auto future = collection.load_async<morphio::Morphology>("complexe");
+        collection.close();
+        REQUIRE(!future.get().points().empty());
+        CHECK_THROWS(collection.load_async<morphio::Morphology>("complexe"));
+    }
+}
+
+TEST_CASE("Collection::load_many", "[collection]") {
+    auto collection = morphio::Collection("data", {".swc", ".asc"});
+    auto morphology_names = std::vector<std::string>{
+        "simple", "complexe", "three_point_soma", "soma_cylinders", "simple"};
+
+    for (size_t n_threads : {size_t(1), size_t(3), size_t(0)}) {
+        auto morphologies = collection.load_many(morphology_names,
+                                                 morphio::Option::NO_MODIFIER,
+                                                 n_threads);
+        REQUIRE(morphologies.size() == morphology_names.size());
+        for (size_t i = 0; i < morphology_names.size(); ++i) {
+            auto expected = collection.load<morphio::Morphology>(morphology_names[i]);
+            REQUIRE(morphologies[i].points() == expected.points());
+            REQUIRE(morphologies[i].sectionOffsets() == expected.sectionOffsets());
+        }
+    }
+
+    CHECK_THROWS_AS(collection.load_many({"simple", "not-there", "complexe"},
+                                         morphio::Option::NO_MODIFIER,
+                                         2),
+                    morphio::MorphioError);
+}
@@ -1,15 +1,19 @@
 #include <cmath>
+#include <cstdint>  // std::uintptr_t
 #include <limits>
 #include <sstream>
+#include <utility>  // std::move
 
 #include <catch2/catch.hpp>
 
 #include <morphio/endoplasmic_reticulum.h>
 #include <morphio/glial_cell.h>
 #include <morphio/morphology.h>
+#include <morphio/morphometrics.h>
 #include <morphio/mut/morphology.h>
 #include <morphio/properties.h>
 #include <morphio/section.h>
+#include <morphio/section_view.h>
 #include <morphio/soma.h>
 #include <morphio/vector_types.h>
 
@@ -29,6 +33,20 @@ class Files
         return res;
     }
 };
+
+/** A morphology built from properties as read from an H5 file, on which `options` apply */
+class FromH5Properties: public morphio::Morphology
+{
+  public:
+    FromH5Properties(morphio::Property::Properties properties, unsigned int options)
+        : morphio::Morphology(withH5Version(std::move(properties)), options) {}
+
+  private:
+    static morphio::Property::Properties withH5Version(morphio::Property::Properties properties) {
+        properties._cellLevel._version = {"h5", 1, 1};
+        return properties;
+    }
+};
 }  // anonymous namespace
 
 TEST_CASE("fromMut", "[immutableMorphology]") {
@@ -131,6 +149,70 @@ TEST_CASE("modifers", "[immutableMorphology]") {
 }
 
 
+TEST_CASE("modifiersOnProperties", "[immutableMorphology]") {
+    for (const auto* path : {"data/reversed_NRN_neurite_order.swc", "data/nrn_ordering.swc"}) {
+        const morphio::mut::Morphology original(path);
+        for (unsigned int options : std::vector<unsigned int>{
+                 morphio::NO_DUPLICATES,
+                 morphio::TWO_POINTS_SECTIONS,
+                 morphio::SOMA_SPHERE,
+                 morphio::NRN_ORDER,
+                 morphio::NO_DUPLICATES | morphio::NRN_ORDER,
+                 morphio::TWO_POINTS_SECTIONS | morphio::SOMA_SPHERE | morphio::NRN_ORDER}) {
+            // The modifiers applied through a mutable morphology
+            const morphio::Morphology expected{morphio::mut::Morphology(original, options)};
+            const FromH5Properties morph(original.buildReadOnly(), options);
+
+            REQUIRE(morph.points() == expected.points());
+            REQUIRE(morph.diameters() == expected.diameters());
+            REQUIRE(morph.sectionTypes() == expected.sectionTypes());
+            REQUIRE(morph.connectivity() == expected.connectivity());
+            REQUIRE(morph.soma().points() == expected.soma().points());
+            REQUIRE(morph.soma().diameters() == expected.soma().diameters());
+            for (const auto& section : morph.sections()) {
+                REQUIRE(section.points() == expected.section(section.id()).points());
+            }
+        }
+    }
+}
+
+TEST_CASE("modifiersOnOrganelles", "[immutableMorphology]") {
+    // The roots are in reverse NEURON order, so NRN_ORDER renumbers the sections
+    morphio::mut::Morphology original("data/reversed_NRN_neurite_order.swc");
+    const auto last = static_cast<uint32_t>(original.sections().size() - 1);
+    const std::vector<uint32_t> ids{last, 0, last / 2};
+    original.mitochondria().appendRootSection(
+        morphio::Property::MitochondriaPointLevel(ids, {0.1f, 0.5f, 0.9f}, {1, 2, 3}));
+    auto& reticulum = original.endoplasmicReticulum();
+    reticulum.sectionIndices() = ids;
+    reticulum.volumes() = {1, 2, 3};
+    reticulum.surfaceAreas() = {4, 5, 6};
+    reticulum.filamentCounts() = {7, 8, 9};
+
+    const morphio::Morphology unmodified(original);
+    const FromH5Properties morph(original.buildReadOnly(), morphio::NRN_ORDER);
+    REQUIRE(morph.rootSections()[0].type() != unmodified.rootSections()[0].type());
+
+    // The organelles refer to the same neurite sections, under their new IDs
+    const auto sameSection = [&](uint32_t id, uint32_t originalId) {
+        const auto points = morph.section(id).points();
+        const auto expected = unmodified.section(originalId).points();
+        return morphio::Points(points.begin(), points.end()) ==
+               morphio::Points(expected.begin(), expected.end());
+    };
+    const auto mitoIds = morph.mitochondria().rootSections()[0].neuriteSectionIds();
+    const auto& reticulumIds = morph.endoplasmicReticulum().sectionIndices();
+    REQUIRE(mitoIds.size() == ids.size());
+    REQUIRE(reticulumIds.size() == ids.size());
+    REQUIRE(std::vector<uint32_t>(mitoIds.begin(), mitoIds.end()) != ids);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        REQUIRE(sameSection(mitoIds[i], ids[i]));
+        REQUIRE(sameSection(reticulumIds[i], ids[i]));
+    }
+    REQUIRE(morph.endoplasmicReticulum().volumes() == reticulum.volumes());
+    REQUIRE(morph.endoplasmicReticulum().filamentCounts() == reticulum.filamentCounts());
+}
+
 TEST_CASE("immutableMorphologySoma", "[immutableMorphology]") {
     Files files;
     for (const auto& morph : files.morphs()) {
@@ -214,6 +296,220 @@ TEST_CASE("iter", "[immutableMorphology]") {
     }
 }
 
+TEST_CASE("iterOrders", "[immutableMorphology]") {
+    const morphio::Morphology morph("data/simple-heterogeneous-neurite.swc");
+
+    // Reference orders, built with the children of every section
+    std::vector<uint32_t> expectedDepth;
+    std::vector<morphio::Section> stack;
+    const auto roots = morph.rootSections();
+    stack.assign(roots.rbegin(), roots.rend());
+    while (!stack.empty()) {
+        const auto section = stack.back();
+        stack.pop_back();
+        expectedDepth.push_back(section.id());
+        const auto children = section.children();
+        stack.insert(stack.end(), children.rbegin(), children.rend());
+    }
+    std::vector<uint32_t> expectedBreadth;
+    std::vector<morphio::Section> queue = roots;
+    for (size_t i = 0; i < queue.size(); ++i) {
+        expectedBreadth.push_back(queue[i].id());
+        const auto children = queue[i].children();
+        queue.insert(queue.end(), children.begin(), children.end());
+    }
+
+    std::vector<uint32_t> depth;
+    for (auto it = morph.depth_begin(); it != morph.depth_end(); ++it) {
+        depth.push_back(it->id());
+    }
+    REQUIRE(depth == expectedDepth);
+
+    std::vector<uint32_t> breadth;
+    for (auto it = morph.breadth_begin(); it != morph.breadth_end(); ++it) {
+        breadth.push_back((*it).id());
+    }
+    REQUIRE(breadth == expectedBreadth);
+
+    const auto section = *std::find_if(roots.begin(), roots.end(), [](const morphio::Section& s) {
+        return !s.children().empty();
+    });
+    std::vector<uint32_t> subtree;
+    for (auto it = section.breadth_begin(); it != section.breadth_end(); ++it) {
+        subtree.push_back(it->id());
+        REQUIRE(std::find(depth.begin(), depth.end(), it->id()) != depth.end());
+    }
+    REQUIRE(subtree.front() == section.id());
+    REQUIRE(subtree.size() > 1);
+    REQUIRE(std::distance(section.depth_begin(), section.depth_end()) ==
+            static_cast<std::ptrdiff_t>(subtree.size()));
+
+    auto end = morph.depth_end();
+    REQUIRE_THROWS_AS(++end, morphio::MorphioError);
+}
+
+TEST_CASE("subtrees", "[immutableMorphology]") {
+    const morphio::Morphology morph("data/simple-heterogeneous-neurite.swc");
+    const auto sections = morph.sections();
+    const auto roots = morph.rootSections();
+
+    for (const auto& section : sections) {
+        std::vector<uint32_t> expected;
+        for (auto it = section.depth_begin(); it != section.depth_end(); ++it) {
+            expected.push_back(it->id());
+        }
+        const auto ids = section.subtreeIds();
+        REQUIRE(std::vector<uint32_t>(ids.begin(), ids.end()) == expected);
+
+        for (const auto& other : sections) {
+            const bool isDescendant = other.id() != section.id() &&
+                                      std::find(expected.begin(), expected.end(), other.id()) !=
+                                          expected.end();
+            REQUIRE(other.isDescendantOf(section) == isDescendant);
+        }
+    }
+
+    // Sections read from SWC are in depth first order: a neurite's points are contiguous
+    for (const auto& root : roots) {
+        size_t count = 0;
+        for (auto it = root.depth_begin(); it != root.depth_end(); ++it) {
+            count += it->points().size();
+        }
+        REQUIRE(root.subtreePoints().size() == count);
+        REQUIRE(root.subtreeDiameters().size() == count);
+        REQUIRE(root.subtreePoints()[0] == root.points()[0]);
+    }
+    const auto lastNeurite = roots.back().subtreePoints();
+    REQUIRE(lastNeurite.data() + lastNeurite.size() ==
+            morph.points().data() + morph.points().size());
+
+    const morphio::Morphology other("data/simple-heterogeneous-neurite.swc");
+    REQUIRE(!other.section(1).isDescendantOf(roots[0]));
+}
+
+TEST_CASE("pointsSoA", "[immutableMorphology]") {
+    const morphio::Morphology morph("data/simple-heterogeneous-neurite.swc");
+
+    const auto soa = morph.pointsSoA();
+    REQUIRE(soa.size() == morph.points().size());
+    REQUIRE(reinterpret_cast<std::uintptr_t>(soa.x.data()) % 64 == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(soa.y.data()) % 64 == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(soa.z.data()) % 64 == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(soa.diameters.data()) % 64 == 0);
+    REQUIRE(morph.pointsSoA().x.data() == soa.x.data());
+
+    for (const auto& section : morph.sections()) {
+        const auto points = section.points();
+        const auto sectionSoA = section.pointsSoA();
+        const auto viewSoA = morph.sectionView(section.id()).pointsSoA();
+        REQUIRE(sectionSoA.size() == points.size());
+        REQUIRE(viewSoA.x.data() == sectionSoA.x.data());
+        for (size_t i = 0; i < points.size(); ++i) {
+            REQUIRE(sectionSoA.x[i] == points[i][0]);
+            REQUIRE(sectionSoA.y[i] == points[i][1]);
+            REQUIRE(sectionSoA.z[i] == points[i][2]);
+            REQUIRE(sectionSoA.diameters[i] == section.diameters()[i]);
+        }
+    }
+}
+
+TEST_CASE("morphometrics", "[immutableMorphology]") {
+    const morphio::Morphology morph("data/simple-heterogeneous-neurite.swc");
+    const auto result = morphio::computeMorphometrics(morph);
+
+    const auto nPoints = morph.points().size();
+    REQUIRE(result.segmentLengths.size() == nPoints);
+    REQUIRE(result.segmentAreas.size() == nPoints);
+    REQUIRE(result.segmentVolumes.size() == nPoints);
+    REQUIRE(result.sectionLengths.size() == morph.sections().size());
+
+    const auto offsets = morph.sectionOffsets();
+    for (const auto& section : morph.sections()) {
+        const auto points = section.points();
+        const auto diameters = section.diameters();
+        morphio::floatType length = 0;
+        morphio::floatType area = 0;
+        morphio::floatType volume = 0;
+        for (size_t i = 0; i + 1 < points.size(); ++i) {
+            const auto dx = points[i + 1][0] - points[i][0];
+            const auto dy = points[i + 1][1] - points[i][1];
+            const auto dz = points[i + 1][2] - points[i][2];
+            const auto h = std::sqrt(dx * dx + dy * dy + dz * dz);
+            const auto r0 = diameters[i] / 2;
+            const auto r1 = diameters[i + 1] / 2;
+            const auto s = std::sqrt((r1 - r0) * (r1 - r0) + h * h);
+            REQUIRE(result.segmentLengths[offsets[section.id()] + i] == Approx(h));
+            length += h;
+            area += morphio::PI * (r0 + r1) * s;
+            volume += morphio::PI * h * (r0 * r0 + r0 * r1 + r1 * r1) / 3;
+        }
+        REQUIRE(result.segmentLengths[offsets[section.id() + 1] - 1] == 0);
+        REQUIRE(result.sectionLengths[section.id()] == Approx(length));
+        REQUIRE(result.sectionAreas[section.id()] == Approx(area));
+        REQUIRE(result.sectionVolumes[section.id()] == Approx(volume));
+    }
+
+    const auto roots = morph.rootSections();
+    REQUIRE(result.neuriteLengths.size() == roots.size());
+    for (size_t i = 0; i < roots.size(); ++i) {
+        morphio::floatType length = 0;
+        for (auto it = roots[i].depth_begin(); it != roots[i].depth_end(); ++it) {
+            length += result.sectionLengths[(*it).id()];
+        }
+        REQUIRE(result.neuriteLengths[i] == Approx(length));
+    }
+
+    // Without a children table, the neurites are found from the sections
+    const auto readOnly = morphio::mut::Morphology(morph).buildReadOnly();
+    REQUIRE(readOnly._sectionLevel._children._offsets.empty());
+    const auto readOnlyResult = morphio::computeMorphometrics(readOnly);
+    REQUIRE(readOnlyResult.neuriteLengths == result.neuriteLengths);
+    REQUIRE(readOnlyResult.neuriteVolumes == result.neuriteVolumes);
+
+    const std::vector<morphio::Morphology> batch(3, morph);
+    const auto batchResult = morphio::computeMorphometrics(batch, 2);
+    REQUIRE(batchResult.size() == 3);
+    for (const auto& r : batchResult) {
+        REQUIRE(r.sectionVolumes == result.sectionVolumes);
+        REQUIRE(r.neuriteAreas == result.neuriteAreas);
+    }
+}
+
+TEST_CASE("pathDistances", "[immutableMorphology]") {
+    const morphio::Morphology morph("data/simple-heterogeneous-neurite.swc");
+    const auto& distances = morph.pathDistances();
+    REQUIRE(distances.size() == morph.points().size());
+    REQUIRE(morph.pathDistances().data() == distances.data());
+
+    const auto length = [](const morphio::range<const morphio::Point>& points) {
+        morphio::floatType total = 0;
+        for (size_t i = 1; i < points.size(); ++i) {
+            const auto dx = points[i][0] - points[i - 1][0];
+            const auto dy = points[i][1] - points[i - 1][1];
+            const auto dz = points[i][2] - points[i - 1][2];
+            total += std::sqrt(dx * dx + dy * dy + dz * dz);
+        }
+        return total;
+    };
+
+    for (const auto& section : morph.sections()) {
+        morphio::floatType upstream = 0;
+        for (auto it = section.upstream_begin(); it != section.upstream_end(); ++it) {
+            if ((*it).id() != section.id()) {
+                upstream += length((*it).points());
+            }
+        }
+
+        const auto points = section.points();
+        const auto sectionDistances = section.pathDistances();
+        REQUIRE(sectionDistances.size() == points.size());
+        REQUIRE(sectionDistances[0] == Approx(upstream));
+        REQUIRE(sectionDistances[points.size() - 1] == Approx(upstream + length(points)));
+        REQUIRE(morph.sectionView(section.id()).pathDistances().data() ==
+                sectionDistances.data());
+    }
+}
+
 TEST_CASE("section_offsets", "[immutableMorphology]") {
     Files files;
     std::vector<uint32_t> expectedSectionOffsets = {0, 2, 4, 6, 8, 10, 12};
@@ -232,6 +528,98 @@ TEST_CASE("connectivity", "[immutableMorphology]") {
     }
 }
 
+TEST_CASE("childrenTable", "[immutableMorphology]") {
+    // (offset, parent): sections 2 and 4 are children of 0, 3 is a child of 2
+    const std::vector<morphio::Property::Section::Type> sections = {
+        {0, -1}, {2, -1}, {4, 0}, {6, 2}, {8, 0}};
+    const morphio::Property::ChildrenTable table(sections);
+    REQUIRE(table._offsets == std::vector<uint32_t>{0, 2, 2, 3, 3, 3});
+    REQUIRE(table._ids == std::vector<uint32_t>{2, 4, 3});
+    REQUIRE(table._roots == std::vector<uint32_t>{0, 1});
+    REQUIRE(table.children(1).empty());
+    REQUIRE(table.children(42).empty());
+    REQUIRE(table.toMap() ==
+            std::map<int, std::vector<unsigned int>>{{-1, {0, 1}}, {0, {2, 4}}, {2, {3}}});
+    REQUIRE(morphio::Property::ChildrenTable::fromMap(table.toMap()) == table);
+
+    REQUIRE_THROWS_AS(morphio::Property::ChildrenTable({{0, 1}}), morphio::RawDataError);
+    // Sections 1 and 2 are their own ancestors, so no root leads to them
+    REQUIRE_THROWS_AS(morphio::Property::ChildrenTable(
+                          std::vector<morphio::Property::Section::Type>{{0, -1}, {2, 2}, {4, 1}}),
+                      morphio::RawDataError);
+    REQUIRE(morphio::Property::ChildrenTable(
+                std::vector<morphio::Property::Section::Type>{{0, 2}, {2, -1}, {4, 1}})
+                ._roots == std::vector<uint32_t>{1});
+    REQUIRE_THROWS_AS(morphio::Property::ChildrenTable::fromMap({{-1, {0}}, {0, {2}}}),
+                      morphio::RawDataError);
+    REQUIRE_THROWS_AS(morphio::Property::ChildrenTable::fromMap({{-1, {0}}, {0, {1}}, {1, {0}}}),
+                      morphio::RawDataError);
+
+    const morphio::Property::TraversalOrders orders(table);
+    REQUIRE(orders._depthFirst == std::vector<uint32_t>{0, 2, 3, 4, 1});
+    REQUIRE(orders._breadthFirst == std::vector<uint32_t>{0, 1, 2, 4, 3});
+    REQUIRE(!orders._isDepthFirstLayout);
+    REQUIRE(orders.entry(2) == 1);
+    REQUIRE(orders.exit(2) == 3);
+    REQUIRE(orders.isDescendant(3, 0));
+    REQUIRE(!orders.isDescendant(0, 0));
+    REQUIRE(!orders.isDescendant(1, 0));
+
+    morphio::Property::SectionLevel level;
+    level._sections = sections;
+    level.setChildren(table);
+    REQUIRE(level.connectivity() == table.toMap());
+    REQUIRE(level.traversal()._depthFirst == orders._depthFirst);
+    // The values derived from the previous table are dropped
+    level.setChildren(morphio::Property::ChildrenTable(
+        std::vector<morphio::Property::Section::Type>{{0, -1}, {2, 0}}));
+    REQUIRE(level.connectivity() ==
+            std::map<int, std::vector<unsigned int>>{{-1, {0}}, {0, {1}}});
+    REQUIRE(level.traversal()._depthFirst == std::vector<uint32_t>{0, 1});
+
+    const auto morph = morphio::Morphology("data/simple.swc");
+    const auto ids = morph.rootSections()[0].childrenIds();
+    REQUIRE(std::vector<uint32_t>(ids.begin(), ids.end()) == std::vector<uint32_t>{1, 2});
+    REQUIRE(morph.section(1).childrenIds().empty());
+}
+
+TEST_CASE("sectionView", "[immutableMorphology]") {
+    const auto morph = morphio::Morphology("data/simple-heterogeneous-neurite.swc");
+
+    const auto roots = morph.rootSectionViews();
+    REQUIRE(roots.size() == morph.rootSections().size());
+    for (const morphio::SectionView root : roots) {
+        REQUIRE(root.isRoot());
+        REQUIRE_THROWS_AS(root.parent(), morphio::MissingParentError);
+    }
+
+    for (const auto& section : morph.sections()) {
+        const auto view = morph.sectionView(section.id());
+        REQUIRE(view.id() == section.id());
+        REQUIRE(view.points() == section.points());
+        REQUIRE(view.diameters() == section.diameters());
+        REQUIRE(view.perimeters() == section.perimeters());
+        REQUIRE(view.type() == section.type());
+        REQUIRE(view.isRoot() == section.isRoot());
+        if (!view.isRoot()) {
+            REQUIRE(view.parent().id() == section.parent().id());
+            REQUIRE(view.parent() == morph.sectionView(section.parent().id()));
+        }
+
+        REQUIRE(view.subtreeIds() == section.subtreeIds());
+        REQUIRE(view.isDescendantOf(*roots.begin()) == section.isDescendantOf(morph.section(0)));
+
+        const auto children = section.children();
+        REQUIRE(view.children().size() == children.size());
+        size_t i = 0;
+        for (const morphio::SectionView child : view.children()) {
+            REQUIRE(child.id() == children[i++].id());
+        }
+    }
+
+    REQUIRE_THROWS_AS(morph.sectionView(42), morphio::RawDataError);
+}
+
 TEST_CASE("endoplasmic_reticulum", "[immutableMorphology]") {
     morphio::Morphology morph = morphio::Morphology("data/h5/v1/endoplasmic-reticulum.h5");
     morphio::EndoplasmicReticulum er = morph.endoplasmicReticulum();
@@ -0,0 +1,173 @@
+#include <catch2/catch.hpp>
+
+#include <morphio/collection.h>
+#include <morphio/morphology.h>
+#include <morphio/morphology_pack.h>
+#include <morphio/soma.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+namespace fs = std::filesystem;
+
+namespace {
+void check_same_morphology(const morphio::Morphology& actual,
+                           const morphio::Morphology& expected) {
+    REQUIRE(actual.points() == expected.points());
+    REQUIRE(actual.diameters() == expected.diameters());
+    REQUIRE(actual.perimeters() == expected.perimeters());
+    REQUIRE(actual.sectionOffsets() == expected.sectionOffsets());
+    REQUIRE(actual.sectionTypes() == expected.sectionTypes());
+    REQUIRE(actual.connectivity() == expected.connectivity());
+    REQUIRE(actual.soma().points() == expected.soma().points());
+    REQUIRE(actual.soma().diameters() == expected.soma().diameters());
+    REQUIRE(actual.somaType() == expected.somaType());
+    REQUIRE(actual.cellFamily() == expected.cellFamily());
+    REQUIRE(actual.version() == expected.version());
+}
+}  // namespace
+
+TEST_CASE("MorphologyPack", "[pack]") {
+    auto tmpDirectory = fs::temp_directory_path() / "test_morphology_pack.cpp";
+    fs::create_directories(tmpDirectory);
+    const std::string packPath = tmpDirectory / "morphologies.pack";
+
+    const std::vector<std::string> names = {
+        "simple", "complexe", "three_point_soma", "simple-heterogeneous-neurite"};
+    const morphio::Collection collection("data", {".swc"});
+    morphio::MorphologyPack::write(packPath, collection, names);
+
+    SECTION("load") {
+        REQUIRE(morphio::MorphologyPack::isPack(packPath));
+        REQUIRE(!morphio::MorphologyPack::isPack("data/simple.swc"));
+
+        const morphio::MorphologyPack pack(packPath);
+        REQUIRE(pack.size() == names.size());
+        REQUIRE(pack.names() == names);
+        REQUIRE(pack.contains("complexe"));
+        REQUIRE(!pack.contains("not-there"));
+        REQUIRE(pack.index("three_point_soma") == 2);
+        REQUIRE_THROWS_AS(pack.index("not-there"), morphio::MorphioError);
+        REQUIRE_THROWS_AS(pack.load(names.size()), morphio::MorphioError);
+
+        for (size_t i = 0; i < names.size(); ++i) {
+            check_same_morphology(pack.load(names[i]),
+                                  morphio::Morphology("data/" + names[i] + ".swc"));
+            REQUIRE(pack.offset(i) % 64 == 0);
+        }
+        REQUIRE(pack.offset(0) < pack.offset(1));
+    }
+
+    SECTION("view") {
+        morphio::PackedMorphology view;
+        {
+            const morphio::MorphologyPack pack(packPath);
+            REQUIRE_THROWS_AS(pack.view(names.size()), morphio::MorphioError);
+            view = pack.view("complexe");
+        }
+        // The view keeps the file mapped once the pack is gone
+        const morphio::Morphology expected("data/complexe.swc");
+        const auto same = [](const auto& actual, const auto& reference) {
+            return std::equal(actual.begin(), actual.end(), reference.begin(), reference.end());
+        };
+        REQUIRE(same(view.points, expected.points()));
+        REQUIRE(same(view.diameters, expected.diameters()));
+        REQUIRE(view.perimeters.empty());
+        REQUIRE(same(view.sectionTypes, expected.sectionTypes()));
+        REQUIRE(view.sections.size() == expected.sectionTypes().size());
+        REQUIRE(same(view.somaPoints, expected.soma().points()));
+        REQUIRE(same(view.somaDiameters, expected.soma().diameters()));
+        REQUIRE(view.somaType == expected.soma().type());
+    }
+
+    SECTION("modifiers") {
+        const morphio::MorphologyPack pack(packPath);
+        for (unsigned int options : std::vector<unsigned int>{
+                 morphio::Option::TWO_POINTS_SECTIONS,
+                 morphio::Option::NO_DUPLICATES,
+                 morphio::Option::NRN_ORDER,
+                 morphio::Option::NO_DUPLICATES | morphio::Option::NRN_ORDER,
+                 morphio::Option::SOMA_SPHERE}) {
+            for (const auto& name : names) {
+                check_same_morphology(pack.load(name, options),
+                                      morphio::Morphology("data/" + name + ".swc", options));
+            }
+        }
+    }
+
+    SECTION("collection") {
+        const morphio::Collection packCollection(packPath);
+        check_same_morphology(packCollection.load<morphio::Morphology>("complexe"),
+                              morphio::Morphology("data/complexe.swc"));
+        REQUIRE(packCollection.load<morphio::mut::Morphology>("simple").rootSections().size() ==
+                2);
+
+        const std::vector<std::string> reversed(names.rbegin(), names.rend());
+        REQUIRE(packCollection.argsort(reversed) == std::vector<size_t>{3, 2, 1, 0});
+    }
+
+    SECTION("batch") {
+        const morphio::Collection packCollection(packPath);
+        const auto expected = collection.load_batch(names);
+        for (unsigned int options :
+             {morphio::Option::NO_MODIFIER, morphio::Option::NO_DUPLICATES}) {
+            const auto actual = packCollection.load_batch(names, options);
+            REQUIRE(actual.size() == names.size());
+            REQUIRE(actual.points().size() <= expected.points().size());
+            REQUIRE(actual.sectionParents() == expected.sectionParents());
+            REQUIRE(actual.sectionTypes() == expected.sectionTypes());
+            REQUIRE(actual.cellSectionOffsets() == expected.cellSectionOffsets());
+            if (options == morphio::Option::NO_MODIFIER) {
+                REQUIRE(actual.points() == expected.points());
+                REQUIRE(actual.diameters() == expected.diameters());
+                REQUIRE(actual.sectionOffsets() == expected.sectionOffsets());
+                REQUIRE(actual.somaPoints() == expected.somaPoints());
+                REQUIRE(actual.somaTypes() == expected.somaTypes());
+                REQUIRE(actual.cellPointOffsets() == expected.cellPointOffsets());
+                REQUIRE(actual.cellSomaPointOffsets() == expected.cellSomaPointOffsets());
+            }
+        }
+    }
+
+    SECTION("invalid") {
+        const std::string truncatedPath = tmpDirectory / "truncated.pack";
+        {
+            std::ifstream in(packPath, std::ios::binary);
+            std::ofstream out(truncatedPath, std::ios::binary);
+            std::vector<char> buffer(100);
+            in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        }
+        REQUIRE_THROWS_AS(morphio::MorphologyPack(truncatedPath), morphio::RawDataError);
+        REQUIRE_THROWS_AS(morphio::MorphologyPack("data/simple.swc"), morphio::RawDataError);
+
+        // Patch the record of the first cell: the cell table offset is at byte 32 of the
+        // header, the file format at byte 16 of a record and the array of array (offset,
+        // count) pairs at byte 48, diameters being the second array
+        const auto patched = [&](size_t recordOffset, const std::string& bytes) {
+            const std::string path = tmpDirectory / "patched.pack";
+            fs::copy_file(packPath, path, fs::copy_options::overwrite_existing);
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            uint64_t cellTableOffset = 0;
+            file.seekg(32);
+            file.read(reinterpret_cast<char*>(&cellTableOffset), sizeof(cellTableOffset));
+            file.seekp(static_cast<std::streamoff>(cellTableOffset + recordOffset));
+            file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            return path;
+        };
+        const morphio::MorphologyPack noTerminator(patched(16, std::string(16, 'x')));
+        REQUIRE(std::get<0>(noTerminator.load(0).version()) == std::string(16, 'x'));
+
+        const uint64_t diameterCount = 1;
+        const morphio::MorphologyPack inconsistent(
+            patched(48 + 16 + 8,
+                    std::string(reinterpret_cast<const char*>(&diameterCount),
+                                sizeof(diameterCount))));
+        REQUIRE_THROWS_AS(inconsistent.load(0), morphio::RawDataError);
+        REQUIRE_THROWS_AS(inconsistent.loadBatch({"simple"}), morphio::RawDataError);
+        REQUIRE_THROWS_AS(morphio::MorphologyPack("data/does-not-exist.pack"),
+                          morphio::RawDataError);
+    }
+
+    fs::remove_all(tmpDirectory);
+}
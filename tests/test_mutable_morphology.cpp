@@ -4,6 +4,9 @@
 #include <morphio/mut/morphology.h>
 
 #include <filesystem>
+#include <map>
+#include <set>
+#include <thread>
 namespace fs = std::filesystem;
 
 TEST_CASE("isHeterogeneous", "[mutableMorphology]") {
@@ -67,6 +70,45 @@ TEST_CASE("RemoveUnifurcation", "[mutableMorphology]") {
     REQUIRE(morph.rootSections()[0]->points().size() == 5);
 }
 
+TEST_CASE("RemoveUnifurcationChain", "[mutableMorphology]") {
+    morphio::set_maximum_warnings(0);
+    morphio::mut::Morphology morph;
+    const auto root = morph.appendRootSection(
+        morphio::Property::PointLevel({{0, 0, 0}, {1, 0, 0}}, {1, 1}),
+        morphio::SectionType::SECTION_AXON);
+    // A chain of single children, the last one without duplicate point
+    auto section = root;
+    for (int i = 1; i < 4; ++i) {
+        const auto x = static_cast<morphio::floatType>(i);
+        section = section->appendSection(
+            morphio::Property::PointLevel({{x, 0, 0}, {x + 1, 0, 0}}, {1, 1}),
+            morphio::SectionType::SECTION_AXON);
+    }
+    section = section->appendSection(morphio::Property::PointLevel({{5, 0, 0}}, {1}),
+                                     morphio::SectionType::SECTION_AXON);
+    for (int i = 0; i < 2; ++i) {
+        const auto y = static_cast<morphio::floatType>(i * 2 - 1);
+        section->appendSection(morphio::Property::PointLevel({{5, 0, 0}, {5, y, 0}}, {1, 1}),
+                               morphio::SectionType::SECTION_AXON);
+    }
+    const auto merged = morph.section(1);
+
+    morph.removeUnifurcations();
+    morphio::set_maximum_warnings(100);
+
+    REQUIRE(morph.sections().size() == 3);
+    REQUIRE(morph.rootSections().size() == 1);
+    REQUIRE(morph.rootSections()[0]->points() ==
+            morphio::Points{{0, 0, 0}, {1, 0, 0}, {2, 0, 0}, {3, 0, 0}, {4, 0, 0}, {5, 0, 0}});
+    REQUIRE(morph.connectivity() ==
+            std::unordered_map<int, std::vector<unsigned int>>{{-1, {0}}, {0, {5, 6}}});
+    REQUIRE(morph.section(5)->parent()->id() == 0);
+    REQUIRE(morph.annotations().size() == 4);
+    REQUIRE(morph.annotations()[0]._sectionId == 1);
+    REQUIRE(morph.annotations()[0]._points._points == morphio::Points{{1, 0, 0}, {2, 0, 0}});
+    REQUIRE_THROWS(merged->parent());
+}
+
 TEST_CASE("mutableConnectivity", "[mutableMorphology]") {
     morphio::mut::Morphology morph("data/simple.asc");
     std::unordered_map<int, std::vector<unsigned int>> expectedConnectivity = {{-1, {0, 3}},
@@ -76,6 +118,391 @@ TEST_CASE("mutableConnectivity", "[mutableMorphology]") {
     REQUIRE(morph.connectivity() == expectedConnectivity);
 }
 
+TEST_CASE("sectionSlots", "[mutableMorphology]") {
+    morphio::mut::Morphology morph("data/simple-heterogeneous-neurite.swc");
+    const auto& sections = morph.sections();
+    REQUIRE(sections.size() == 6);
+    REQUIRE(morph.section(1)->parent()->id() == 0);
+    REQUIRE(morph.section(0)->isRoot());
+    REQUIRE_THROWS_AS(morph.section(0)->parent(), std::out_of_range);
+
+    // Deleting a root makes its children roots
+    morph.deleteSection(morph.section(0), false);
+    REQUIRE_THROWS_AS(morph.section(0), std::out_of_range);
+    REQUIRE(morph.section(1)->isRoot());
+    REQUIRE(morph.section(2)->isRoot());
+    REQUIRE(morph.rootSections().size() == 3);
+    // The map is derived from the slots again, in place
+    REQUIRE(&morph.sections() == &sections);
+    REQUIRE(sections.size() == 5);
+    REQUIRE(sections.begin()->first == 1);
+
+    // Deleting an inner section attaches its children to their grandparent
+    const auto leaf = morph.section(4)->appendSection(morph.section(5)->properties(),
+                                                      morphio::SectionType::SECTION_AXON);
+    REQUIRE(leaf->id() == 6);
+    morph.deleteSection(morph.section(4), false);
+    REQUIRE(leaf->parent()->id() == 3);
+    REQUIRE(morph.section(3)->children().size() == 2);
+    REQUIRE(morph.connectivity() == std::unordered_map<int, std::vector<unsigned int>>{
+                                        {-1, {1, 2, 3}}, {3, {6, 5}}});
+
+    // Copying a subtree of the morphology into itself, the new slots being appended
+    // while the children of the original sections are iterated over
+    const auto copy = morph.appendRootSection(morph.section(3), true);
+    REQUIRE(copy->children().size() == 2);
+    REQUIRE(morph.sections().size() == 8);
+    REQUIRE(morph.sections().rbegin()->first == 9);
+}
+
+TEST_CASE("deleteSections", "[mutableMorphology]") {
+    const auto depthFirstIds = [](const morphio::mut::Morphology& morph) {
+        std::vector<uint32_t> ids;
+        for (auto it = morph.depth_begin(); it != morph.depth_end(); ++it) {
+            ids.push_back((*it)->id());
+        }
+        return ids;
+    };
+
+    const morphio::mut::Morphology original("data/nrn_ordering.swc");
+    // Every third section, some of them descendants of others, plus unknown IDs
+    std::set<uint32_t> ids;
+    for (const auto& section : original.sections()) {
+        if (section.first % 3 == 1) {
+            ids.insert(section.first);
+        }
+    }
+
+    for (bool recursive : {false, true}) {
+        // A section is kept if neither it nor, when recursive, one of its ancestors is deleted.
+        // The parent of a kept section is its closest kept ancestor.
+        std::vector<uint32_t> expectedOrder;
+        std::map<uint32_t, int> expectedParents;
+        for (auto id : depthFirstIds(original)) {
+            bool kept = ids.count(id) == 0;
+            int parent = -1;
+            for (auto it = original.section(id)->upstream_begin();
+                 it != original.section(id)->upstream_end();
+                 ++it) {
+                const auto ancestor = (*it)->id();
+                if (ancestor == id) {
+                    continue;
+                }
+                if (ids.count(ancestor) == 0) {
+                    parent = parent == -1 ? static_cast<int>(ancestor) : parent;
+                } else if (recursive) {
+                    kept = false;
+                }
+            }
+            if (kept) {
+                expectedOrder.push_back(id);
+                expectedParents[id] = parent;
+            }
+        }
+
+        morphio::mut::Morphology morph(original);
+        std::vector<uint32_t> toDelete(ids.begin(), ids.end());
+        toDelete.push_back(100000);
+        toDelete.push_back(toDelete[0]);
+        const auto deleted = morph.section(toDelete[0]);
+        morph.deleteSections(toDelete, recursive);
+
+        REQUIRE(depthFirstIds(morph) == expectedOrder);
+        REQUIRE(morph.sections().size() == expectedOrder.size());
+        for (const auto& section : morph.sections()) {
+            const int parent = section.second->isRoot()
+                                   ? -1
+                                   : static_cast<int>(section.second->parent()->id());
+            REQUIRE(parent == expectedParents.at(section.first));
+        }
+        REQUIRE_THROWS(deleted->children());
+    }
+}
+
+TEST_CASE("destruction", "[mutableMorphology]") {
+    std::shared_ptr<morphio::mut::Section> root;
+    std::shared_ptr<morphio::mut::Section> leaf;
+    {
+        morphio::mut::Morphology morph("data/nrn_ordering.swc");
+        root = morph.rootSections()[0];
+        for (auto it = morph.depth_begin(); it != morph.depth_end(); ++it) {
+            leaf = *it;
+        }
+    }
+    // Sections kept alive are detached from the destroyed morphology
+    REQUIRE_THROWS(root->children());
+    REQUIRE_THROWS(leaf->parent());
+    REQUIRE(!root->points().empty());
+    REQUIRE(!leaf->points().empty());
+}
+
+TEST_CASE("buildReadOnly", "[mutableMorphology]") {
+    for (const auto* path : {"data/nrn_ordering.swc", "data/simple-heterogeneous-neurite.swc"}) {
+        morphio::mut::Morphology morph(path);
+        // Only some sections have perimeters
+        auto& perimeters = morph.rootSections()[0]->perimeters();
+        perimeters.assign(morph.rootSections()[0]->points().size(), 1);
+
+        // The properties appended section by section in depth first order
+        std::map<uint32_t, int> newIds;
+        std::vector<std::array<int, 2>> sections;
+        std::vector<morphio::SectionType> types;
+        morphio::Points points;
+        std::vector<morphio::floatType> diameters;
+        for (auto it = morph.depth_begin(); it != morph.depth_end(); ++it) {
+            const auto& section = *it;
+            const int parent = section->isRoot() ? -1 : newIds.at(section->parent()->id());
+            newIds[section->id()] = static_cast<int>(sections.size());
+            sections.push_back({static_cast<int>(points.size()), parent});
+            types.push_back(section->type());
+            points.insert(points.end(), section->points().begin(), section->points().end());
+            diameters.insert(diameters.end(),
+                             section->diameters().begin(),
+                             section->diameters().end());
+        }
+
+        for (size_t n_threads : {1, 4}) {
+            const auto properties = morph.buildReadOnly(n_threads);
+            REQUIRE(properties._sectionLevel._sections == sections);
+            REQUIRE(properties._sectionLevel._sectionTypes == types);
+            REQUIRE(properties._pointLevel._points == points);
+            REQUIRE(properties._pointLevel._diameters == diameters);
+            REQUIRE(properties._pointLevel._perimeters == perimeters);
+        }
+    }
+}
+
+TEST_CASE("appendSections", "[mutableMorphology]") {
+    const morphio::Morphology original("data/nrn_ordering.swc");
+    const auto properties = morphio::mut::Morphology(original).buildReadOnly();
+
+    morphio::mut::Morphology morph;
+    morph.soma()->properties() = properties._somaLevel;
+    const auto sections = morph.appendSections(properties._pointLevel,
+                                               properties._sectionLevel._sections,
+                                               properties._sectionLevel._sectionTypes);
+    REQUIRE(sections.size() == original.sections().size());
+    REQUIRE(morph.sections().size() == sections.size());
+    for (uint32_t i = 0; i < sections.size(); ++i) {
+        REQUIRE(sections[i]->id() == i);
+    }
+
+    const morphio::Morphology built(morph);
+    REQUIRE(built.points() == original.points());
+    REQUIRE(built.diameters() == original.diameters());
+    REQUIRE(built.sectionTypes() == original.sectionTypes());
+    REQUIRE(built.connectivity() == original.connectivity());
+
+    // Appending again adds new roots, and inherits the type of the parent when undefined
+    const morphio::Property::PointLevel points({{0, 0, 0}, {1, 0, 0}, {1, 0, 0}, {2, 0, 0}},
+                                               {1, 1, 1, 1});
+    const auto added = morph.appendSections(points,
+                                            {{0, -1}, {2, 0}},
+                                            {morphio::SECTION_AXON, morphio::SECTION_UNDEFINED});
+    REQUIRE(added[0]->id() == sections.size());
+    REQUIRE(added[0]->isRoot());
+    REQUIRE(added[1]->parent()->id() == added[0]->id());
+    REQUIRE(added[1]->type() == morphio::SECTION_AXON);
+    REQUIRE(added[1]->points() == morphio::Points{{1, 0, 0}, {2, 0, 0}});
+    REQUIRE(morph.rootSections().size() == original.rootSections().size() + 1);
+
+    CHECK_THROWS_AS(morph.appendSections(points, {{0, 0}}, {morphio::SECTION_AXON}),
+                    morphio::SectionBuilderError);
+    CHECK_THROWS_AS(morph.appendSections(points, {{3, -1}, {2, 0}}, {morphio::SECTION_AXON,
+                                                                     morphio::SECTION_AXON}),
+                    morphio::SectionBuilderError);
+    CHECK_THROWS_AS(morph.appendSections(points, {{0, -1}}, {}), morphio::SectionBuilderError);
+    CHECK_THROWS_AS(morph.appendSections(points, {{0, -1}}, {morphio::SECTION_SOMA}),
+                    morphio::SectionBuilderError);
+}
+
+TEST_CASE("repeatedConversions", "[mutableMorphology]") {
+    morphio::mut::Morphology morph("data/nrn_ordering.swc");
+    const auto check = [&morph]() {
+        const morphio::Morphology expected{morphio::mut::Morphology(morph)};
+        const morphio::Morphology converted(morph);
+        REQUIRE(converted.points() == expected.points());
+        REQUIRE(converted.diameters() == expected.diameters());
+        REQUIRE(converted.perimeters() == expected.perimeters());
+        REQUIRE(converted.sectionTypes() == expected.sectionTypes());
+        REQUIRE(converted.connectivity() == expected.connectivity());
+        REQUIRE(morph.buildReadOnly(4)._pointLevel._points == expected.points());
+    };
+    check();
+    check();
+
+    // An edit through a reference taken before a conversion is seen by the next one
+    auto& points = morph.section(5)->points();
+    check();
+    points[0] = {999, 999, 999};
+    check();
+    REQUIRE(morphio::Morphology(morph).section(5).points()[0] == morphio::Point{999, 999, 999});
+
+    // Edit the points of a few sections, changing their sizes
+    std::vector<uint32_t> ids;
+    for (const auto& section : morph.sections()) {
+        ids.push_back(section.first);
+    }
+    auto section = morph.section(ids[ids.size() / 3]);
+    section->points().push_back({1, 2, 3});
+    section->diameters().push_back(4);
+    section = morph.section(ids[ids.size() / 2]);
+    section->points().pop_back();
+    section->diameters().pop_back();
+    morph.section(ids.back())->diameters()[0] = 42;
+    check();
+
+    // Change the structure: sections move in the depth first order
+    morph.deleteSection(morph.section(ids[ids.size() / 4]), false);
+    morph.deleteSection(morph.section(ids[2 * ids.size() / 3]), true);
+    auto root = morph.rootSections()[0];
+    root->appendSection(morphio::Property::PointLevel({{0, 0, 0}, {1, 1, 1}}, {2, 2}),
+                        morphio::SECTION_AXON);
+    check();
+    morph.removeUnifurcations();
+    check();
+}
+
+TEST_CASE("snapshots", "[mutableMorphology]") {
+    const morphio::Morphology original("data/nrn_ordering.swc");
+    morphio::mut::Morphology morph(original);
+    morphio::mut::Snapshot snapshot;
+    REQUIRE(snapshot.morphology() == nullptr);
+    const auto check = [&morph, &snapshot](size_t n_threads) {
+        snapshot = morph.buildSnapshot(snapshot, n_threads);
+        const morphio::Morphology expected{morphio::mut::Morphology(morph)};
+        const auto& actual = *snapshot.morphology();
+        REQUIRE(actual.points() == expected.points());
+        REQUIRE(actual.diameters() == expected.diameters());
+        REQUIRE(actual.perimeters() == expected.perimeters());
+        REQUIRE(actual.sectionTypes() == expected.sectionTypes());
+        REQUIRE(actual.connectivity() == expected.connectivity());
+    };
+    check(1);
+    check(4);
+    REQUIRE(snapshot.morphology()->points() == original.points());
+
+    // An edit through a reference taken before a snapshot is seen by the next one
+    auto& points = morph.section(5)->points();
+    check(1);
+    points[0] = {999, 999, 999};
+    check(1);
+    REQUIRE(snapshot.morphology()->section(5).points()[0] == morphio::Point{999, 999, 999});
+
+    // Sections trimmed by the modifiers, without handing out their data
+    morphio::mut::modifiers::no_duplicate_point(morph, 1);
+    check(2);
+    morphio::mut::modifiers::two_points_sections(morph, 1);
+    check(1);
+
+    // Sections moving in the depth first order, and new ones
+    morph.deleteSection(morph.section(3), false);
+    morph.rootSections()[0]->appendSection(
+        morphio::Property::PointLevel({{0, 0, 0}, {1, 1, 1}}, {2, 2}), morphio::SECTION_AXON);
+    check(1);
+    morph.section(7)->diameters()[1] = 42;
+    check(1);
+
+    // A snapshot of another morphology is not used
+    const morphio::mut::Morphology other("data/simple.swc");
+    const auto otherSnapshot = other.buildSnapshot(snapshot);
+    REQUIRE(otherSnapshot.morphology()->points() == morphio::Morphology(other).points());
+}
+
+TEST_CASE("copyOnWrite", "[mutableMorphology]") {
+    const morphio::Morphology original("data/nrn_ordering.swc");
+    morphio::mut::Morphology morph(original);
+    REQUIRE(morphio::Morphology(morph).points() == original.points());
+    REQUIRE(morphio::mut::Morphology(morph).buildReadOnly()._pointLevel._points ==
+            original.points());
+
+    const morphio::mut::Section& constSection = *morph.section(10);
+    const auto originalPoints = original.section(10).points();
+    REQUIRE(constSection.points() ==
+            morphio::Points(originalPoints.begin(), originalPoints.end()));
+    morph.section(20)->points()[0] = {1, 2, 3};
+    morph.section(30)->diameters().push_back(4);
+    morph.section(30)->points().push_back({4, 5, 6});
+
+    // The sections that were not accessed mutably still come from the original
+    const morphio::Morphology expected{morphio::mut::Morphology(morph)};
+    const morphio::Morphology edited(morph);
+    REQUIRE(edited.points() == expected.points());
+    REQUIRE(edited.diameters() == expected.diameters());
+    REQUIRE(edited.points()[original.sectionOffsets()[20]] == morphio::Point{1, 2, 3});
+    REQUIRE(edited.points()[original.sectionOffsets()[31]] == morphio::Point{4, 5, 6});
+    REQUIRE(edited.points().size() == original.points().size() + 1);
+
+    // Concurrent reads of sections not accessed yet copy their data once
+    const morphio::mut::Morphology shared(original);
+    std::vector<std::thread> readers;
+    std::vector<size_t> counts(4, 0);
+    for (size_t t = 0; t < counts.size(); ++t) {
+        readers.emplace_back([&shared, &counts, t]() {
+            for (const auto& it : shared.sections()) {
+                const morphio::mut::Section& section = *it.second;
+                counts[t] += section.points().size();
+            }
+        });
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    for (size_t count : counts) {
+        REQUIRE(count == original.points().size());
+    }
+    REQUIRE(morphio::Morphology(shared).points() == original.points());
+
+    // Perimeters are taken from the original as well
+    const auto properties = morphio::mut::Morphology(original).buildReadOnly();
+    morphio::mut::Morphology withPerimeters;
+    auto points = properties._pointLevel;
+    points._perimeters.assign(points._points.size(), 1);
+    for (size_t i = 0; i < points._perimeters.size(); ++i) {
+        points._perimeters[i] = static_cast<morphio::floatType>(i);
+    }
+    withPerimeters.appendSections(points,
+                                  properties._sectionLevel._sections,
+                                  properties._sectionLevel._sectionTypes);
+    const morphio::Morphology perimeterOriginal(withPerimeters);
+    morphio::mut::Morphology perimeterCopy(perimeterOriginal);
+    REQUIRE(morphio::Morphology(perimeterCopy).perimeters() == points._perimeters);
+    perimeterCopy.section(5)->perimeters()[0] = -1;
+    points._perimeters[perimeterOriginal.sectionOffsets()[5]] = -1;
+    REQUIRE(morphio::Morphology(perimeterCopy).perimeters() == points._perimeters);
+}
+
+TEST_CASE("parallelModifiers", "[mutableMorphology]") {
+    const morphio::Morphology original("data/nrn_ordering.swc");
+    for (size_t n_threads : {1, 4}) {
+        morphio::mut::Morphology trimmed(original);
+        morphio::mut::Morphology twoPoints(original);
+        // Both the sections still backed by the original and the copied ones are processed
+        trimmed.section(3)->diameters();
+        twoPoints.section(3)->diameters();
+        morphio::mut::modifiers::no_duplicate_point(trimmed, n_threads);
+        morphio::mut::modifiers::two_points_sections(twoPoints, n_threads);
+
+        for (const auto& section : original.sections()) {
+            const auto points = section.points();
+            const auto diameters = section.diameters();
+            const auto first = section.isRoot() ? 0 : 1;
+            REQUIRE(trimmed.section(section.id())->points() ==
+                    morphio::Points(points.begin() + first, points.end()));
+            REQUIRE(trimmed.section(section.id())->diameters() ==
+                    std::vector<morphio::floatType>(diameters.begin() + first, diameters.end()));
+            REQUIRE(twoPoints.section(section.id())->points() ==
+                    morphio::Points{points[0], points[points.size() - 1]});
+            REQUIRE(twoPoints.section(section.id())->diameters() ==
+                    std::vector<morphio::floatType>{diameters[0], diameters[diameters.size() - 1]});
+        }
+
+        morphio::mut::Morphology viaFlags(original);
+        viaFlags.applyModifiers(morphio::TWO_POINTS_SECTIONS, n_threads);
+        REQUIRE(morphio::Morphology(viaFlags).points() == morphio::Morphology(twoPoints).points());
+    }
+}
+
 TEST_CASE("writing", "[mutableMorphology]") {
     morphio::mut::Morphology morph("data/simple.asc");
     auto tmpDirectory = std::filesystem::temp_directory_path() / "test_mutable_morphology.cpp";
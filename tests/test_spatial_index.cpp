@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include <catch2/catch.hpp>
+
+#include <morphio/circuit_index.h>
+#include <morphio/morphology.h>
+#include <morphio/mut/morphology.h>
+#include <morphio/mut/section.h>
+#include <morphio/section.h>
+#include <morphio/spatial_index.h>
+
+namespace {
+
+struct Capsule {
+    morphio::Point start;
+    morphio::Point end;
+    morphio::floatType radius;
+    morphio::SegmentId id;
+};
+
+std::vector<Capsule> capsules(const morphio::Morphology& morphology) {
+    std::vector<Capsule> result;
+    for (const auto& section : morphology.sections()) {
+        const auto points = section.points();
+        const auto diameters = section.diameters();
+        for (uint32_t i = 0; i + 1 < points.size(); ++i) {
+            result.push_back({points[i],
+                              points[i + 1],
+                              std::max(diameters[i], diameters[i + 1]) / 2,
+                              {section.id(), i}});
+        }
+    }
+    return result;
+}
+
+morphio::floatType distanceToSegment(const morphio::Point& point, const Capsule& capsule) {
+    morphio::floatType squaredLength = 0;
+    morphio::floatType projection = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        const auto direction = capsule.end[i] - capsule.start[i];
+        squaredLength += direction * direction;
+        projection += direction * (point[i] - capsule.start[i]);
+    }
+    const auto t = squaredLength > 0
+                       ? std::min(std::max(projection / squaredLength, morphio::floatType{0}),
+                                  morphio::floatType{1})
+                       : morphio::floatType{0};
+    morphio::floatType result = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        const auto d = point[i] - capsule.start[i] - t * (capsule.end[i] - capsule.start[i]);
+        result += d * d;
+    }
+    return std::sqrt(result);
+}
+
+morphio::floatType dot(const morphio::Point& a, const morphio::Point& b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+morphio::Point difference(const morphio::Point& a, const morphio::Point& b) {
+    return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+/** Return the distance between the closest points of the segments of `a` and `b` */
+morphio::floatType distanceBetweenSegments(const Capsule& a, const Capsule& b) {
+    const auto clamp = [](morphio::floatType value) {
+        return std::min(std::max(value, morphio::floatType{0}), morphio::floatType{1});
+    };
+    const auto u = difference(a.end, a.start);
+    const auto v = difference(b.end, b.start);
+    const auto w = difference(a.start, b.start);
+    const auto uu = dot(u, u);
+    const auto vv = dot(v, v);
+    const auto uv = dot(u, v);
+    const auto uw = dot(u, w);
+    const auto vw = dot(v, w);
+
+    // Closest point of the line of `a` to the line of `b`, then of `b` to that point, each
+    // clamped to its segment
+    morphio::floatType s = 0;
+    morphio::floatType t = 0;
+    const auto denominator = uu * vv - uv * uv;
+    if (uu > 0 && vv > 0) {
+        s = denominator > 0 ? clamp((uv * vw - vv * uw) / denominator) : 0;
+        t = (uv * s + vw) / vv;
+        if (t < 0 || t > 1) {
+            t = clamp(t);
+            s = clamp((uv * t - uw) / uu);
+        }
+    } else if (uu > 0) {
+        s = clamp(-uw / uu);
+    } else if (vv > 0) {
+        t = clamp(vw / vv);
+    }
+
+    morphio::floatType result = 0;
+    for (size_t i = 0; i < 3; ++i) {
+        const auto d = w[i] + s * u[i] - t * v[i];
+        result += d * d;
+    }
+    return std::sqrt(result);
+}
+
+std::vector<morphio::SegmentId> bruteForceSphere(const std::vector<Capsule>& capsules,
+                                                 const morphio::Point& center,
+                                                 morphio::floatType radius) {
+    std::vector<morphio::SegmentId> result;
+    for (const auto& capsule : capsules) {
+        if (distanceToSegment(center, capsule) <= radius + capsule.radius) {
+            result.push_back(capsule.id);
+        }
+    }
+    return result;
+}
+
+morphio::Points randomPoints(const morphio::SegmentIndex& index, size_t n) {
+    const auto bounds = index.bounds();
+    std::mt19937 generator(42);
+    morphio::Points result(n);
+    for (auto& point : result) {
+        for (size_t i = 0; i < 3; ++i) {
+            std::uniform_real_distribution<morphio::floatType> distribution(bounds[0][i],
+                                                                            bounds[1][i]);
+            point[i] = distribution(generator);
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("SegmentIndex", "[spatialIndex]") {
+    const morphio::Morphology morphology("data/nrn_ordering.swc");
+    const auto expected = capsules(morphology);
+
+    for (size_t n_threads : {1, 4}) {
+        const morphio::SegmentIndex index(morphology, n_threads);
+        REQUIRE(index.size() == expected.size());
+
+        const auto centers = randomPoints(index, 50);
+        const std::vector<morphio::floatType> radii(centers.size(), 20);
+        const auto spheres = index.sphereQuery(centers, radii, 2);
+        const auto nearest = index.nearest(centers, 2);
+        for (size_t i = 0; i < centers.size(); ++i) {
+            REQUIRE(spheres[i] == bruteForceSphere(expected, centers[i], radii[i]));
+
+            auto best = std::numeric_limits<morphio::floatType>::max();
+            for (const auto& capsule : expected) {
+                best = std::min(best,
+                                std::max(distanceToSegment(centers[i], capsule) - capsule.radius,
+                                         morphio::floatType{0}));
+            }
+            REQUIRE(nearest[i].distance == Approx(best));
+        }
+
+        const auto bounds = index.bounds();
+        REQUIRE(index.boxQuery(bounds[0], bounds[1]).size() == expected.size());
+        const morphio::Point far{bounds[1][0] + 1, bounds[1][1] + 1, bounds[1][2] + 1};
+        REQUIRE(index.boxQuery(far, far).empty());
+    }
+
+    const morphio::Points centers{{0, 0, 0}};
+    CHECK_THROWS_AS(morphio::SegmentIndex(morphology).sphereQuery(centers, {}),
+                    morphio::MorphioError);
+}
+
+TEST_CASE("CircuitIndex", "[spatialIndex]") {
+    const morphio::Morphology morphology("data/simple-heterogeneous-neurite.swc");
+    const morphio::Transform identity{{{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}}};
+    // A rotation of 90 degrees around z, exact in floating point
+    const morphio::Transform rotation{{{0, -1, 0, 0}, {1, 0, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}}};
+    const morphio::Transform far{{{1, 0, 0, 1e5}, {0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}}};
+
+    // The same rotation, applied to the points up front
+    morphio::mut::Morphology rotatedCopy(morphology);
+    for (const auto& section : rotatedCopy.sections()) {
+        for (auto& point : section.second->points()) {
+            point = {-point[1], point[0], point[2]};
+        }
+    }
+
+    const morphio::CircuitIndex placed({morphology, morphology, morphology},
+                                       {identity, rotation, far});
+    const morphio::Morphology rotated(rotatedCopy);
+    const morphio::CircuitIndex copied({morphology, rotated},
+                                       {identity, identity});
+    REQUIRE(placed.size() == 3);
+    REQUIRE(placed.cellPairs(0.5) == std::vector<std::array<uint32_t, 2>>{{0, 1}});
+    REQUIRE(placed.cellBounds(2)[0][0] >= 1e5 - 100);
+
+    const auto pairs = placed.segmentPairs(0.5, 2);
+    const auto expected = copied.segmentPairs(0.5, 1);
+    REQUIRE(!pairs.empty());
+    REQUIRE(pairs.size() == expected.size());
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        REQUIRE(pairs[i].cell0 == 0);
+        REQUIRE(pairs[i].cell1 == 1);
+        REQUIRE(pairs[i].segment0 == expected[i].segment0);
+        REQUIRE(pairs[i].segment1 == expected[i].segment1);
+    }
+
+    // Every segment pair found by brute force over the segments of both cells
+    size_t bruteForce = 0;
+    const auto rotatedCapsules = capsules(rotated);
+    for (const auto& capsule : capsules(morphology)) {
+        for (const auto& other : rotatedCapsules) {
+            if (distanceBetweenSegments(capsule, other) <= capsule.radius + other.radius + 0.5) {
+                ++bruteForce;
+            }
+        }
+    }
+    REQUIRE(pairs.size() == bruteForce);
+
+    morphio::Transform scaling = identity;
+    scaling[0][0] = 2;
+    CHECK_THROWS_AS(morphio::CircuitIndex({morphology}, {scaling}), morphio::MorphioError);
+    CHECK_THROWS_AS(morphio::CircuitIndex({morphology}, {}), morphio::MorphioError);
+}
+
+TEST_CASE("SegmentIndexBenchmark", "[.][benchmark]") {
+    const morphio::Morphology morphology("data/nrn_ordering.swc");
+    const auto expected = capsules(morphology);
+
+    using clock = std::chrono::steady_clock;
+    auto start = clock::now();
+    const morphio::SegmentIndex index(morphology, 0);
+    const auto buildTime = clock::now() - start;
+
+    const auto centers = randomPoints(index, 10000);
+    start = clock::now();
+    size_t indexHits = 0;
+    for (const auto& center : centers) {
+        indexHits += index.sphereQuery(center, 5).size();
+    }
+    const auto indexTime = clock::now() - start;
+
+    start = clock::now();
+    size_t bruteForceHits = 0;
+    for (const auto& center : centers) {
+        bruteForceHits += bruteForceSphere(expected, center, 5).size();
+    }
+    const auto bruteForceTime = clock::now() - start;
+
+    REQUIRE(indexHits == bruteForceHits);
+    using ms = std::chrono::duration<double, std::milli>;
+    WARN(expected.size() << " segments, build: " << ms(buildTime).count()
+                         << " ms, index queries: " << ms(indexTime).count()
+                         << " ms, brute force queries: " << ms(bruteForceTime).count() << " ms");
+}